@@ -1,11 +1,34 @@
 #pragma once
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
+#include <bit>
+#include <chrono>
 #include <cstddef>
-#include <mutex>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 /**
  * @brief Lock-free ring buffer implementation for high-performance
  * producer/consumer workflows
@@ -17,11 +40,14 @@
  * guarantee thread safety.
  *
  * @section Assumptions
- * - Capacity is compile-time constant and a power of two for efficient
- * indexing.
+ * - Capacity is a power of two for efficient indexing. It is either a
+ * compile-time constant or, with ringmaster::DynamicCapacity, chosen when the
+ * ring is constructed.
  * - Only one thread calls push(), and only one thread calls pop().
- * - Type Q_TYPE supports nothrow move construction and assignment; copying is
- * avoided.
+ * - Type Q_TYPE supports nothrow move construction and destruction; copying is
+ * avoided. It need not be default-constructible: slots are raw storage and
+ * an element only exists between the push that constructs it and the pop,
+ * remove() or clear() that destroys it.
  *
  * @section Usage
  * @code
@@ -38,93 +64,2204 @@
  *
  * @tparam Q_TYPE Element type stored in the ring; must be movable without
  * throwing.
+ * @tparam CacheIndices When true, each side keeps a private copy of the
+ * opposite index and only reloads the shared one when the copy reports the
+ * ring as full (producer) or empty (consumer).
+ * @tparam WaitStrategy Policy deciding how push_wait()/pop_wait() spend the
+ * time between failed attempts (see ringmaster::HybridWait and friends).
+ * @tparam Stats Statistics policy: ringmaster::NullStats (no overhead) or
+ * ringmaster::CountingStats (per-side counters readable via stats()).
+ */
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64 // Default cache line size in bytes
+#endif
+
+/*
+ * Hardware parameters probed by tools/cacheLineSize.cc and injected by
+ * CMakeLists.txt. The defaults below apply when the header is used without
+ * the CMake build.
+ */
+#ifndef DESTRUCTIVE_INTERFERENCE_SIZE
+#define DESTRUCTIVE_INTERFERENCE_SIZE CACHE_LINE_SIZE // Spacing between data of different threads
+#endif
+#ifndef L1D_CACHE_SIZE
+#define L1D_CACHE_SIZE 32768 // L1 data cache per core in bytes
+#endif
+#ifndef L2_CACHE_SIZE
+#define L2_CACHE_SIZE 262144 // L2 cache in bytes
+#endif
+#ifndef CPU_CORES
+#define CPU_CORES 1 // Physical cores
+#endif
+#ifndef HW_THREADS
+#define HW_THREADS 1 // Logical CPUs
+#endif
+#ifndef SMT_WIDTH
+#define SMT_WIDTH 1 // Hardware threads per core
+#endif
+
+static_assert(DESTRUCTIVE_INTERFERENCE_SIZE >= CACHE_LINE_SIZE &&
+                  DESTRUCTIVE_INTERFERENCE_SIZE % CACHE_LINE_SIZE == 0,
+    "DESTRUCTIVE_INTERFERENCE_SIZE must be a multiple of CACHE_LINE_SIZE");
+
+namespace ringmaster {
+
+/**
+ * @struct Hardware
+ * @brief Compile-time view of the probed cache and CPU parameters
+ *
+ * `interference` is the spacing used for every padded index and flag: on
+ * Intel the spatial prefetcher pulls 64-byte lines in pairs, so it is twice
+ * the line size there. `l1d` sizes the default batch of consume_all().
+ */
+struct Hardware {
+  static constexpr size_t cache_line   = CACHE_LINE_SIZE;               /**< Line size in bytes */
+  static constexpr size_t interference = DESTRUCTIVE_INTERFERENCE_SIZE; /**< Padding in bytes */
+  static constexpr size_t l1d          = L1D_CACHE_SIZE;                /**< L1D bytes per core */
+  static constexpr size_t l2           = L2_CACHE_SIZE;                 /**< L2 bytes */
+  static constexpr size_t cores        = CPU_CORES;                     /**< Physical cores */
+  static constexpr size_t threads      = HW_THREADS;                    /**< Logical CPUs */
+  static constexpr size_t smt_width    = SMT_WIDTH;                     /**< Threads per core */
+};
+
+/**
+ * @brief Capacity value selecting a ring whose size is set at construction
+ *
+ * @code
+ * RingMaster<MyType, ringmaster::DynamicCapacity> buffer(1 << 20, ringmaster::HugePages::Explicit);
+ * @endcode
+ */
+inline constexpr size_t DynamicCapacity = 0;
+
+/**
+ * @enum HugePages
+ * @brief Page backing requested for runtime-sized slot storage
+ */
+enum class HugePages {
+  None,        /**< Regular cache-line aligned heap allocation */
+  Transparent, /**< 2 MB aligned anonymous mapping advised with MADV_HUGEPAGE */
+  Explicit     /**< MAP_HUGETLB mapping; falls back to Transparent if unavailable */
+};
+
+/** NUMA node value leaving runtime-sized slot storage to the default policy */
+inline constexpr int AnyNumaNode = -1;
+
+/**
+ * @brief Hint to the CPU that the caller is spinning
+ *
+ * Emits PAUSE on x86 and YIELD on ARM, which lowers power draw and frees
+ * pipeline resources for an SMT sibling while waiting on another core.
+ */
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#else
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/**
+ * @brief Ask the CPU to start loading the cache line holding `addr`
+ */
+inline void prefetch_read(const void *addr) noexcept {
+#if defined(__GNUC__)
+  __builtin_prefetch(addr, 0, 3);
+#elif defined(__x86_64__) || defined(__i386__)
+  _mm_prefetch(static_cast<const char *>(addr), _MM_HINT_T0);
+#else
+  (void)addr;
+#endif
+}
+
+/**
+ * @struct PaddedAtomic
+ * @brief Cache-aligned atomic counter to avoid false sharing
+ *
+ * Each atomic variable is padded to DESTRUCTIVE_INTERFERENCE_SIZE, so it
+ * shares neither its cache line nor its prefetch pair with anything else,
+ * preventing contention between threads operating on head and tail indices.
+ */
+struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) PaddedAtomic {
+  std::atomic<size_t> var; /**< Atomic index counter (head or tail) */
+  char pad[DESTRUCTIVE_INTERFERENCE_SIZE - sizeof(std::atomic<size_t>)]; /**< Padding */
+};
+
+/**
+ * @struct PaddedIndex
+ * @brief Cache-aligned plain index owned by exactly one thread
+ *
+ * Holds a side-private snapshot of the opposite index. It lives on its own
+ * cache line so that refreshing it never invalidates the shared indices.
+ */
+struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) PaddedIndex {
+  size_t var;                                                 /**< Copy of the opposite index */
+  char   pad[DESTRUCTIVE_INTERFERENCE_SIZE - sizeof(size_t)]; /**< Padding */
+};
+
+/**
+ * @struct PaddedFlag
+ * @brief Cache-aligned 32-bit word used to park a waiting thread
+ *
+ * 32 bits so std::atomic::wait/notify map directly onto a futex on Linux.
+ */
+struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) PaddedFlag {
+  std::atomic<uint32_t> var; /**< 1 while a thread is parked (or about to park) */
+  char pad[DESTRUCTIVE_INTERFERENCE_SIZE - sizeof(std::atomic<uint32_t>)]; /**< Padding */
+};
+
+/**
+ * @struct EventCount
+ * @brief Cache-aligned parking spot for any number of waiting threads
+ *
+ * Used where more than one thread may block on the same condition. A waiter
+ * calls wait_until(), which registers with prepare(), re-checks its
+ * condition and then either calls cancel() or wait() with the returned
+ * epoch. A notifier publishes its state change and calls notify_all(), which
+ * skips the syscall when nobody is registered. The fences on both sides
+ * ensure that either the waiter's re-check sees the state change or the
+ * notifier sees the waiter.
+ */
+struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) EventCount {
+  std::atomic<uint32_t> epoch{0};   /**< Bumped by every notify that finds waiters */
+  std::atomic<uint32_t> waiters{0}; /**< Threads between prepare() and wait()/cancel() */
+
+  uint32_t prepare() noexcept {
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    return epoch.load(std::memory_order_seq_cst);
+  }
+
+  void cancel() noexcept { waiters.fetch_sub(1, std::memory_order_relaxed); }
+
+  void wait(uint32_t observed) noexcept {
+    epoch.wait(observed, std::memory_order_acquire);
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Block until `ready()` holds or a notify_all() arrives
+   *
+   * Returns without blocking if `ready()` already holds once registered;
+   * callers re-check their condition after a wake-up.
+   */
+  template<typename READY> void wait_until(READY &&ready) noexcept {
+    const uint32_t observed = prepare();
+    // Pairs with the fence in notify_all() before the re-check
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ready()) {
+      cancel();
+      return;
+    }
+    wait(observed);
+  }
+
+  void notify_all() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed)) {
+      epoch.fetch_add(1, std::memory_order_release);
+      epoch.notify_all();
+    }
+  }
+};
+
+/*
+ * Wait strategies
+ *
+ * A wait strategy is constructed at the start of every push_wait() /
+ * pop_wait() call with the caller's `spin_limit`, and again after each
+ * time the thread parks. After every failed attempt the ring calls
+ * `spin()`; returning true retries immediately, returning false parks the
+ * thread until the opposite side makes progress. Strategies whose `parks`
+ * constant is false never park, which also lets the opposite side skip
+ * its wake-up check entirely.
+ */
+
+/**
+ * @struct BusySpinWait
+ * @brief Spin with a PAUSE hint after every attempt; never parks
+ *
+ * For latency-critical rings whose threads own isolated cores.
+ */
+struct BusySpinWait {
+  static constexpr bool parks = false;
+
+  explicit BusySpinWait(size_t /*spin_limit*/ = 0) noexcept {}
+
+  bool spin() noexcept {
+    cpu_relax();
+    return true;
+  }
+};
+
+/**
+ * @struct BackoffWait
+ * @brief Spin with exponentially growing bursts of PAUSE; never parks
+ *
+ * Each failed attempt doubles the number of PAUSE instructions issued
+ * before the next one, up to MaxPauses. Reduces coherence traffic on the
+ * opposite side's index line when waits last longer than a few hundred
+ * nanoseconds.
+ */
+template<size_t MaxPauses = 64> struct BackoffWait {
+  static constexpr bool parks = false;
+
+  explicit BackoffWait(size_t /*spin_limit*/ = 0) noexcept {}
+
+  bool spin() noexcept {
+    for (size_t i = 0; i < pauses_; ++i) cpu_relax();
+    if (pauses_ < MaxPauses) pauses_ <<= 1;
+    return true;
+  }
+
+private:
+  size_t pauses_ = 1; /**< PAUSE instructions issued on the next spin() */
+};
+
+/**
+ * @struct YieldWait
+ * @brief Yield the time slice after every attempt; never parks
+ *
+ * For threads sharing cores with other work that still must not sleep.
+ */
+struct YieldWait {
+  static constexpr bool parks = false;
+
+  explicit YieldWait(size_t /*spin_limit*/ = 0) noexcept {}
+
+  bool spin() noexcept {
+    std::this_thread::yield();
+    return true;
+  }
+};
+
+/**
+ * @struct BlockWait
+ * @brief Park as soon as one attempt fails
+ *
+ * For rings whose threads share cores (e.g. logging), where a spinning
+ * waiter would steal cycles from the thread it is waiting for.
+ */
+struct BlockWait {
+  static constexpr bool parks = true;
+
+  explicit BlockWait(size_t /*spin_limit*/ = 0) noexcept {}
+
+  bool spin() noexcept { return false; }
+};
+
+/**
+ * @struct HybridWait
+ * @brief Spin with PAUSE, then park (the default)
+ *
+ * Spins for up to `spin_limit` attempts or SpinNanos of wall time,
+ * whichever comes first, then parks. The clock is only read every 64
+ * attempts so the common short wait never pays for it.
+ */
+template<uint64_t SpinNanos = 50000> struct HybridWait {
+  static constexpr bool parks = true;
+
+  explicit HybridWait(size_t spin_limit = 1024) noexcept : limit_(spin_limit) {}
+
+  bool spin() noexcept {
+    if (++spins_ >= limit_) return false;
+    if ((spins_ & 63) == 0) {
+      const auto now = std::chrono::steady_clock::now();
+      if (spins_ == 64) {
+        deadline_ = now + std::chrono::nanoseconds(SpinNanos);
+      } else if (now >= deadline_) {
+        return false;
+      }
+    }
+    cpu_relax();
+    return true;
+  }
+
+private:
+  size_t                                limit_;     /**< Attempts before parking */
+  size_t                                spins_ = 0; /**< Failed attempts so far */
+  std::chrono::steady_clock::time_point deadline_;  /**< Park once reached */
+};
+
+/*
+ * Slot layouts
+ *
+ * The sixth RingMaster template parameter decides where logical index i
+ * lives in the slot array and how far ahead the consumer prefetches. A
+ * layout provides:
+ *   slot_bytes<Q_TYPE>        distance in bytes between two physical slots
+ *   position<Q_TYPE>(i, mask) physical slot holding logical index i
+ *   contiguous                true if consecutive indices use consecutive
+ *                             slots (required, together with
+ *                             slot_bytes == sizeof(Q_TYPE), by the span
+ *                             APIs try_claim() and peek())
+ *   prefetch                  slots ahead of tail the consumer prefetches
+ *                             while draining; 0 disables prefetching
+ *
+ * With small elements the default DenseLayout packs several slots into one
+ * cache line, so the producer writing slot i + 1 invalidates the line the
+ * consumer is reading slot i from. PaddedLayout and SwizzledLayout remove
+ * that sharing at the cost of memory and of spatial locality respectively.
+ */
+
+/**
+ * @struct DenseLayout
+ * @brief Slots packed back to back (the default)
+ *
+ * @tparam PrefetchDistance Slots ahead of tail to prefetch (0 = none)
+ */
+template<size_t PrefetchDistance = 0> struct DenseLayout {
+  static constexpr bool   contiguous = true;
+  static constexpr size_t prefetch   = PrefetchDistance;
+
+  template<typename Q_TYPE> static constexpr size_t slot_bytes = sizeof(Q_TYPE);
+
+  template<typename Q_TYPE> static constexpr size_t position(size_t index, size_t mask) noexcept {
+    return index & mask;
+  }
+};
+
+/**
+ * @struct PaddedLayout
+ * @brief Every slot rounded up to whole cache lines
+ *
+ * No two elements ever share a line, for up to CACHE_LINE_SIZE / sizeof
+ * times the memory of DenseLayout.
+ *
+ * @tparam PrefetchDistance Slots ahead of tail to prefetch (0 = none)
+ */
+template<size_t PrefetchDistance = 0> struct PaddedLayout {
+  static constexpr bool   contiguous = true;
+  static constexpr size_t prefetch   = PrefetchDistance;
+
+  template<typename Q_TYPE>
+  static constexpr size_t slot_bytes =
+      (sizeof(Q_TYPE) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE;
+
+  template<typename Q_TYPE> static constexpr size_t position(size_t index, size_t mask) noexcept {
+    return index & mask;
+  }
+};
+
+/**
+ * @struct SwizzledLayout
+ * @brief Consecutive indices spread round-robin over the cache lines
+ *
+ * With E elements per line and L lines, index i lives in line i mod L at
+ * offset (i / L) mod E, so neighbouring indices are always on different
+ * lines while the ring keeps DenseLayout's footprint. Each line is
+ * revisited only every L indices; combine with a prefetch distance to hide
+ * the lost spatial locality. Rings smaller than two lines are left dense.
+ *
+ * @tparam PrefetchDistance Slots ahead of tail to prefetch (0 = none)
+ */
+template<size_t PrefetchDistance = 0> struct SwizzledLayout {
+  static constexpr bool   contiguous = false;
+  static constexpr size_t prefetch   = PrefetchDistance;
+
+  template<typename Q_TYPE> static constexpr size_t slot_bytes = sizeof(Q_TYPE);
+
+  template<typename Q_TYPE> static constexpr size_t position(size_t index, size_t mask) noexcept {
+    static_assert(sizeof(Q_TYPE) <= CACHE_LINE_SIZE && CACHE_LINE_SIZE % sizeof(Q_TYPE) == 0,
+        "SwizzledLayout needs an element size dividing the cache line; use PaddedLayout");
+    constexpr size_t per_line = CACHE_LINE_SIZE / sizeof(Q_TYPE);
+    static_assert((per_line & (per_line - 1)) == 0, "Elements per line must be a power of two");
+    constexpr int line_shift = std::countr_zero(per_line);
+
+    const size_t lines = (mask + 1) >> line_shift;
+    index &= mask;
+    if (lines < 2) return index;
+    return ((index & (lines - 1)) << line_shift) | (index >> std::countr_zero(lines));
+  }
+};
+
+/*
+ * Statistics policies
+ *
+ * The fifth RingMaster template parameter selects a stats policy stored
+ * inside the ring. The producer calls the producer-side hooks (pushed,
+ * fullHit, producerSpins, producerParked) and the consumer the
+ * consumer-side ones, so each counter has exactly one writer. NullStats
+ * makes every hook an empty inline function and occupies no storage.
+ */
+
+/**
+ * @struct NullStats
+ * @brief Statistics policy that records nothing (the default)
+ */
+struct NullStats {
+  void pushed(size_t /*n*/) noexcept {}
+  void popped(size_t /*n*/) noexcept {}
+  void fullHit() noexcept {}
+  void emptyHit() noexcept {}
+  void producerSpins(size_t /*n*/) noexcept {}
+  void consumerSpins(size_t /*n*/) noexcept {}
+  void producerParked() noexcept {}
+  void consumerParked() noexcept {}
+};
+
+/**
+ * @struct StatsSnapshot
+ * @brief Copy of the CountingStats counters at one point in time
+ */
+struct StatsSnapshot {
+  uint64_t pushes         = 0; /**< Elements published by the producer */
+  uint64_t pops           = 0; /**< Elements consumed or discarded by the consumer */
+  uint64_t full_hits      = 0; /**< Push attempts that found the ring full */
+  uint64_t empty_hits     = 0; /**< Pop attempts that found the ring empty */
+  uint64_t producer_spins = 0; /**< Failed attempts spun away in push_wait() */
+  uint64_t consumer_spins = 0; /**< Failed attempts spun away in pop_wait() */
+  uint64_t producer_parks = 0; /**< Times push_wait() parked */
+  uint64_t consumer_parks = 0; /**< Times pop_wait() parked */
+};
+
+/**
+ * @class CountingStats
+ * @brief Statistics policy with per-side, cache-line isolated counters
+ *
+ * Producer and consumer counters live on separate cache lines, so counting
+ * never moves a line between the two threads. Each counter has a single
+ * writer and is updated with a relaxed load and store rather than a
+ * read-modify-write, which compiles to a plain increment; the atomics only
+ * make it legal for a monitoring thread to call snapshot() concurrently.
+ */
+class CountingStats {
+  /**
+   * @struct Side
+   * @brief Counters written by one thread
+   */
+  struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) Side {
+    std::atomic<uint64_t> ops{0};    /**< Elements pushed or popped */
+    std::atomic<uint64_t> misses{0}; /**< Full or empty hits */
+    std::atomic<uint64_t> spins{0};  /**< Failed attempts in the *_wait() calls */
+    std::atomic<uint64_t> parks{0};  /**< Parks in the *_wait() calls */
+  };
+
+  static void bump(std::atomic<uint64_t> &counter, uint64_t n) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+  Side producer_; /**< Written by the producer only */
+  Side consumer_; /**< Written by the consumer only */
+
+public:
+  void pushed(size_t n) noexcept { bump(producer_.ops, n); }
+  void popped(size_t n) noexcept { bump(consumer_.ops, n); }
+  void fullHit() noexcept { bump(producer_.misses, 1); }
+  void emptyHit() noexcept { bump(consumer_.misses, 1); }
+  void producerSpins(size_t n) noexcept { bump(producer_.spins, n); }
+  void consumerSpins(size_t n) noexcept { bump(consumer_.spins, n); }
+  void producerParked() noexcept { bump(producer_.parks, 1); }
+  void consumerParked() noexcept { bump(consumer_.parks, 1); }
+
+  /**
+   * @brief Read all counters; callable from any thread
+   *
+   * Counters are read individually, so a snapshot taken while the ring is
+   * in use may be off by the operations in flight.
+   */
+  StatsSnapshot snapshot() const noexcept {
+    StatsSnapshot s;
+    s.pushes         = producer_.ops.load(std::memory_order_relaxed);
+    s.pops           = consumer_.ops.load(std::memory_order_relaxed);
+    s.full_hits      = producer_.misses.load(std::memory_order_relaxed);
+    s.empty_hits     = consumer_.misses.load(std::memory_order_relaxed);
+    s.producer_spins = producer_.spins.load(std::memory_order_relaxed);
+    s.consumer_spins = consumer_.spins.load(std::memory_order_relaxed);
+    s.producer_parks = producer_.parks.load(std::memory_order_relaxed);
+    s.consumer_parks = consumer_.parks.load(std::memory_order_relaxed);
+    return s;
+  }
+};
+
+namespace detail {
+
+/** Huge page size assumed for mapping alignment */
+inline constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+/**
+ * @brief Bind the pages of [addr, addr + len) to NUMA node `node`
+ *
+ * Issues the mbind(2) system call directly (MPOL_BIND, moving any pages
+ * already touched), so no libnuma is needed. Pages are then allocated on
+ * `node` when first written.
+ *
+ * @return true if the kernel accepted the policy
+ */
+inline bool bind_to_node(void *addr, size_t len, int node) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+  constexpr int      MPOL_BIND_MODE = 2;      // MPOL_BIND from <linux/mempolicy.h>
+  constexpr unsigned MPOL_MOVE_FLAG = 1 << 1; // MPOL_MF_MOVE
+  constexpr int      MASK_BITS      = 1024;
+
+  if (node < 0 || node >= MASK_BITS) return false;
+  unsigned long mask[MASK_BITS / (8 * sizeof(unsigned long))] = {};
+  mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+  return ::syscall(SYS_mbind, addr, len, MPOL_BIND_MODE, mask, MASK_BITS + 1, MPOL_MOVE_FLAG) == 0;
+#else
+  (void)addr;
+  (void)len;
+  (void)node;
+  return false;
+#endif
+}
+
+/**
+ * @struct NoDeadline
+ * @brief Deadline tag for waits that never time out
+ */
+struct NoDeadline {};
+
+/**
+ * @brief Block while `word` holds `expected`, until woken by wake_word()
+ *
+ * Talks to the futex directly on Linux, so a waiter parked with a timeout
+ * and one parked without are woken the same way. May return spuriously;
+ * callers re-check their condition.
+ */
+inline void park_word(std::atomic<uint32_t> &word, uint32_t expected) noexcept {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr,
+      nullptr, 0);
+#else
+  word.wait(expected, std::memory_order_acquire);
+#endif
+}
+
+/**
+ * @brief park_word() giving up after `timeout`
+ *
+ * Without a futex the thread sleeps in short slices instead, so a wake-up
+ * is noticed within 50 microseconds.
+ */
+inline void park_word_for(
+    std::atomic<uint32_t> &word, uint32_t expected, std::chrono::nanoseconds timeout) noexcept {
+  if (timeout <= std::chrono::nanoseconds::zero()) return;
+#if defined(__linux__)
+  const struct timespec ts{static_cast<time_t>(timeout.count() / 1'000'000'000),
+      static_cast<long>(timeout.count() % 1'000'000'000)};
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, &ts,
+      nullptr, 0);
+#else
+  if (word.load(std::memory_order_acquire) == expected) {
+    const std::chrono::nanoseconds slice = std::chrono::microseconds(50);
+    std::this_thread::sleep_for(timeout < slice ? timeout : slice);
+  }
+#endif
+}
+
+/**
+ * @brief Wake one thread parked on `word`
+ */
+inline void wake_word(std::atomic<uint32_t> &word) noexcept {
+#if defined(__linux__)
+  ::syscall(
+      SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+  word.notify_one();
+#endif
+}
+
+/**
+ * @brief Pushed batches of at least this many bytes use streaming stores
+ *
+ * Half the L2: a batch this large would evict the copying thread's own
+ * working set, and the other side will read it from a shared cache level
+ * or DRAM anyway.
+ */
+inline constexpr size_t STREAMING_COPY_THRESHOLD = L2_CACHE_SIZE / 2;
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+/*
+ * Non-temporal copy kernels
+ *
+ * Each copies `len` bytes (a multiple of 64) to a 64-byte aligned `dst`
+ * with streaming stores that bypass the cache. The caller issues the
+ * SFENCE that orders them before the index publication.
+ */
+__attribute__((target("avx512f"))) inline void stream_avx512(
+    std::byte *dst, const std::byte *src, size_t len) noexcept {
+  for (size_t i = 0; i < len; i += 64) {
+    _mm512_stream_si512(reinterpret_cast<__m512i *>(dst + i), _mm512_loadu_si512(src + i));
+  }
+}
+
+__attribute__((target("avx2"))) inline void stream_avx2(
+    std::byte *dst, const std::byte *src, size_t len) noexcept {
+  for (size_t i = 0; i < len; i += 64) {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 32));
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i), lo);
+    _mm256_stream_si256(reinterpret_cast<__m256i *>(dst + i + 32), hi);
+  }
+}
+
+__attribute__((target("sse2"))) inline void stream_sse2(
+    std::byte *dst, const std::byte *src, size_t len) noexcept {
+  for (size_t i = 0; i < len; i += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i),
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+  }
+}
+
+using StreamKernel = void (*)(std::byte *, const std::byte *, size_t) noexcept;
+
+/**
+ * @brief Widest streaming kernel the build or, failing that, the CPU supports
+ *
+ * Resolved at compile time when the target ISA is known (-march=native);
+ * portable builds check CPUID once on first use.
+ */
+inline StreamKernel stream_kernel() noexcept {
+#if defined(__AVX512F__)
+  return stream_avx512;
+#elif defined(__AVX2__)
+  return stream_avx2;
+#else
+  static const StreamKernel kernel = []() -> StreamKernel {
+    if (__builtin_cpu_supports("avx512f")) return stream_avx512;
+    if (__builtin_cpu_supports("avx2")) return stream_avx2;
+    return stream_sse2;
+  }();
+  return kernel;
+#endif
+}
+
+/**
+ * @brief Streaming half of bulk_copy()
+ *
+ * The unaligned head and tail go through memcpy and the 64-byte aligned body
+ * through a non-temporal kernel, followed by an SFENCE so the stores are
+ * globally visible before the caller's release store of the index. Kept out
+ * of line so GCC does not check it against small push_n() sources it is never
+ * reached with (a false -Wstringop-overread).
+ */
+[[gnu::noinline]] inline void stream_copy(std::byte *d, const std::byte *s, size_t bytes) noexcept {
+  const size_t head = (64 - (reinterpret_cast<uintptr_t>(d) & 63)) & 63;
+  std::memcpy(d, s, head);
+  d += head;
+  s += head;
+  bytes -= head;
+
+  const size_t body = bytes & ~size_t(63);
+  stream_kernel()(d, s, body);
+  std::memcpy(d + body, s + body, bytes - body);
+  _mm_sfence();
+}
+#endif
+
+/**
+ * @brief memcpy for ring batches, bypassing the cache for very large ones
+ *
+ * Below STREAMING_COPY_THRESHOLD this is plain memcpy, which is already
+ * vectorized and keeps the data hot for a consumer on a sibling core. Above
+ * it, the copy goes through stream_copy().
+ */
+inline void bulk_copy(void *dst, const void *src, size_t bytes) noexcept {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  if (bytes >= STREAMING_COPY_THRESHOLD) {
+    stream_copy(static_cast<std::byte *>(dst), static_cast<const std::byte *>(src), bytes);
+    return;
+  }
+#endif
+  std::memcpy(dst, src, bytes);
+}
+
+/**
+ * @class RingStorage
+ * @brief Inline slot array for compile-time capacities
+ *
+ * The slots are uninitialized bytes; RingMaster constructs and destroys
+ * elements in them as they are pushed and popped. Slots are `SlotBytes`
+ * apart, which the slot layout may set above sizeof(Q_TYPE) to pad them.
+ * The first slot is aligned to `Align` bytes.
+ */
+template<typename Q_TYPE,
+    size_t Capacity,
+    size_t SlotBytes = sizeof(Q_TYPE),
+    size_t Align     = DESTRUCTIVE_INTERFERENCE_SIZE>
+class RingStorage {
+  static_assert(SlotBytes >= sizeof(Q_TYPE) && SlotBytes % alignof(Q_TYPE) == 0,
+      "Slot stride must hold an aligned Q_TYPE");
+  static_assert((Align & (Align - 1)) == 0, "Slot alignment must be a power of two");
+
+  /** Slot memory, kept clear of the indices and aligned for Q_TYPE */
+  alignas(Align) alignas(Q_TYPE) std::byte buffer_[Capacity * SlotBytes];
+
+public:
+  static constexpr size_t capacity() noexcept { return Capacity; }
+  static constexpr size_t mask() noexcept { return Capacity - 1; }
+  static constexpr bool   huge_pages() noexcept { return false; }
+  static constexpr int    numa_node() noexcept { return AnyNumaNode; }
+
+  Q_TYPE *data() noexcept { return std::launder(reinterpret_cast<Q_TYPE *>(buffer_)); }
+
+  /** Address of physical slot `position` */
+  Q_TYPE *slot(size_t position) noexcept {
+    return std::launder(reinterpret_cast<Q_TYPE *>(buffer_ + position * SlotBytes));
+  }
+};
+
+/**
+ * @class RingStorage<Q_TYPE, DynamicCapacity>
+ * @brief Heap or mmap backed slot array sized at construction
+ *
+ * The descriptor (pointer and mask) is only written by the constructor, so
+ * it sits on its own cache line where both threads can keep it shared.
+ * The slots are left uninitialized, as in the inline specialization.
+ * Heap storage is aligned to `Align` (at least a cache line); mapped
+ * storage starts on a page, or a huge page when huge pages are requested.
  */
+template<typename Q_TYPE, size_t SlotBytes, size_t Align>
+class alignas(std::min<size_t>(Align, DESTRUCTIVE_INTERFERENCE_SIZE))
+    RingStorage<Q_TYPE, DynamicCapacity, SlotBytes, Align> {
+  static_assert(SlotBytes >= sizeof(Q_TYPE) && SlotBytes % alignof(Q_TYPE) == 0,
+      "Slot stride must hold an aligned Q_TYPE");
+  static_assert((Align & (Align - 1)) == 0, "Slot alignment must be a power of two");
+
+  // Alignment handed to the aligned operator new
+  static constexpr std::align_val_t HeapAlign{std::max<size_t>(Align, CACHE_LINE_SIZE)};
+
+  Q_TYPE *buffer_ = nullptr;     /**< First slot, cache-line (or huge-page) aligned */
+  size_t  mask_   = 0;           /**< Capacity - 1 */
+  size_t  bytes_  = 0;           /**< Length of the mapping, 0 for heap storage */
+  bool    huge_   = false;       /**< MAP_HUGETLB mapped or MADV_HUGEPAGE accepted */
+  int     node_   = AnyNumaNode; /**< NUMA node the slots are bound to */
+
+public:
+  /**
+   * @brief Allocate storage for `capacity` elements
+   *
+   * Binding to a NUMA node is best effort: if the kernel rejects the
+   * policy the storage is kept and numa_node() reports AnyNumaNode.
+   *
+   * @param capacity Number of slots; must be a non-zero power of two
+   * @param pages Requested page backing
+   * @param numa_node Node to place the slots on, or AnyNumaNode
+   * @throws std::invalid_argument if capacity is not a power of two
+   * @throws std::bad_alloc if the memory cannot be obtained
+   */
+  RingStorage(size_t capacity, HugePages pages, int numa_node = AnyNumaNode) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("RingMaster capacity must be a non-zero power of two");
+    }
+    if (capacity > SIZE_MAX / SlotBytes) throw std::bad_alloc();
+
+    mask_              = capacity - 1;
+    const size_t bytes = capacity * SlotBytes;
+    void        *mem   = nullptr;
+
+#if defined(__linux__)
+    if (pages != HugePages::None) {
+      const size_t len = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+      if (pages == HugePages::Explicit) {
+        mem = ::mmap(nullptr, len, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (mem == MAP_FAILED) mem = nullptr;
+        huge_ = mem != nullptr;
+      }
+      if (!mem) mem = map_transparent(len, huge_);
+      if (!mem) throw std::bad_alloc();
+      bytes_ = len;
+    } else if (numa_node != AnyNumaNode) {
+      // mbind() works on whole pages, so take them straight from mmap
+      const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+      const size_t len  = (bytes + page - 1) & ~(page - 1);
+      mem = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mem == MAP_FAILED) throw std::bad_alloc();
+      bytes_ = len;
+    }
+    if (mem && numa_node != AnyNumaNode && bind_to_node(mem, bytes_, numa_node)) node_ = numa_node;
+#else
+    (void)pages;
+    (void)numa_node;
+#endif
+    if (!mem) mem = ::operator new(bytes, HeapAlign);
+
+    buffer_ = static_cast<Q_TYPE *>(mem);
+  }
+
+  ~RingStorage() {
+#if defined(__linux__)
+    if (bytes_) {
+      ::munmap(buffer_, bytes_);
+      return;
+    }
+#endif
+    ::operator delete(buffer_, HeapAlign);
+  }
+
+  RingStorage(const RingStorage &)            = delete;
+  RingStorage &operator=(const RingStorage &) = delete;
+
+  size_t capacity() const noexcept { return mask_ + 1; }
+  size_t mask() const noexcept { return mask_; }
+  bool   huge_pages() const noexcept { return huge_; }
+  int    numa_node() const noexcept { return node_; }
+
+  Q_TYPE *data() noexcept { return buffer_; }
+
+  /** Address of physical slot `position` */
+  Q_TYPE *slot(size_t position) noexcept {
+    if constexpr (SlotBytes == sizeof(Q_TYPE)) {
+      return buffer_ + position;
+    } else {
+      return std::launder(reinterpret_cast<Q_TYPE *>(
+          reinterpret_cast<std::byte *>(buffer_) + position * SlotBytes));
+    }
+  }
+
+private:
+#if defined(__linux__)
+  /**
+   * @brief Map `len` bytes aligned to HUGE_PAGE_SIZE and advise THP
+   *
+   * Over-maps by one huge page and trims both ends so the kernel can back
+   * the region with 2 MB pages from the first byte. `advised` is set to
+   * whether the kernel accepted MADV_HUGEPAGE; it rejects the advice when
+   * built without THP support.
+   */
+  static void *map_transparent(size_t len, bool &advised) noexcept {
+    void *raw = ::mmap(nullptr, len + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    const uintptr_t start   = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = (start + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    if (aligned > start) ::munmap(raw, aligned - start);
+    const uintptr_t end = start + len + HUGE_PAGE_SIZE;
+    if (end > aligned + len) ::munmap(reinterpret_cast<void *>(aligned + len), end - aligned - len);
+
+    void *mem = reinterpret_cast<void *>(aligned);
+#if defined(MADV_HUGEPAGE)
+    advised = ::madvise(mem, len, MADV_HUGEPAGE) == 0;
+#else
+    advised = false;
+#endif
+    return mem;
+  }
+#endif
+};
+
+} // namespace detail
+
+/*
+ * Ring layout traits
+ *
+ * A slot layout may also decide the footprint of the ring around the
+ * slots. ringmaster::RingLayout wraps any slot layout and adds, at compile
+ * time:
+ *   index_type     unsigned type of head_ and tail_; indices wrap modulo its
+ *                  range, so Capacity may be at most half of it
+ *   padding        alignment (and so stride) of each index and waiter flag
+ *   waiting        whether the ring carries the waiter flags and the
+ *                  waiting calls (push_wait(), pop_wait(), the timed
+ *                  variants and close())
+ *   slot_alignment alignment of the slot array
+ *
+ * Layouts without these members keep the classic footprint: size_t indices
+ * and waiter flags each on their own DESTRUCTIVE_INTERFERENCE_SIZE block.
+ */
+
+/**
+ * @struct RingLayout
+ * @brief Slot layout plus compile-time choices for the ring's own footprint
+ *
+ * @tparam Slots Slot layout (DenseLayout, PaddedLayout or SwizzledLayout)
+ * @tparam Index Unsigned index type; uint32_t halves the index words of
+ * small rings
+ * @tparam Padding Alignment of each index and flag; a power of two
+ * @tparam Waiting false to drop the waiter flags and the waiting calls
+ * @tparam SlotAlign Alignment of the slot array; a power of two
+ */
+template<typename Slots = DenseLayout<>,
+    typename Index      = size_t,
+    size_t Padding      = DESTRUCTIVE_INTERFERENCE_SIZE,
+    bool Waiting        = true,
+    size_t SlotAlign    = DESTRUCTIVE_INTERFERENCE_SIZE>
+struct RingLayout : Slots {
+  static_assert(std::is_unsigned_v<Index>, "Ring indices must be unsigned");
+
+  using index_type                       = Index;
+  static constexpr size_t padding        = Padding;
+  static constexpr bool   waiting        = Waiting;
+  static constexpr size_t slot_alignment = SlotAlign;
+};
+
+/**
+ * @brief Smallest footprint, for thousands of small polled rings
+ *
+ * 32-bit indices on one cache line each and no waiter flags, so only the
+ * non-waiting calls are available.
+ */
+template<typename Slots = DenseLayout<>>
+using CompactLayout = RingLayout<Slots, uint32_t, CACHE_LINE_SIZE, false, CACHE_LINE_SIZE>;
+
+/**
+ * @brief Inline slot array starting on a huge page boundary
+ *
+ * Lets a compile-time sized ring in static or huge-page backed memory
+ * cover its slots with the fewest TLB entries.
+ */
+template<typename Slots = DenseLayout<>>
+using HugePageLayout =
+    RingLayout<Slots, size_t, DESTRUCTIVE_INTERFERENCE_SIZE, true, detail::HUGE_PAGE_SIZE>;
+
+namespace detail {
+
+/**
+ * @struct Padded
+ * @brief `T` alone on a block of `Padding` bytes
+ */
+template<typename T, size_t Padding> struct alignas(Padding) Padded {
+  static_assert((Padding & (Padding - 1)) == 0 && Padding >= alignof(T),
+      "Padding must be a power of two no smaller than the alignment of T");
+
+  T var; /**< The padded value */
+};
+
+/**
+ * @struct LayoutTraits
+ * @brief Footprint choices of a Layout policy; the classic ring by default
+ */
+template<typename LAYOUT> struct LayoutTraits {
+  using index_type                       = size_t;
+  static constexpr size_t padding        = DESTRUCTIVE_INTERFERENCE_SIZE;
+  static constexpr bool   waiting        = true;
+  static constexpr size_t slot_alignment = DESTRUCTIVE_INTERFERENCE_SIZE;
+};
+
+template<typename LAYOUT>
+  requires requires { typename LAYOUT::index_type; }
+struct LayoutTraits<LAYOUT> {
+  using index_type                       = typename LAYOUT::index_type;
+  static constexpr size_t padding        = LAYOUT::padding;
+  static constexpr bool   waiting        = LAYOUT::waiting;
+  static constexpr size_t slot_alignment = LAYOUT::slot_alignment;
+};
+
+} // namespace detail
+} // namespace ringmaster
+
+/**
+ * @class RingMaster
+ * @brief Lock-free circular buffer for single-producer/single-consumer patterns
+ *
+ * RingMaster provides constant-time push and pop operations with minimal
+ * latency. Internally, it uses two atomic counters (head_ and tail_) padded to
+ * cache lines to prevent false sharing. The buffer array is also aligned
+ * to 64-byte boundaries.
+ *
+ * With CacheIndices enabled, push() only touches tail_'s cache line when its
+ * cached copy of tail_ says the ring is full, and pop() only touches head_'s
+ * line when its cached copy of head_ says the ring is empty. In steady state
+ * this removes one cross-core cache-line transfer per operation.
+ *
+ * The Layout policy places logical indices in the slot array (see
+ * ringmaster::DenseLayout, PaddedLayout and SwizzledLayout) and sets how far
+ * ahead of tail_ pop(), consume(), consume_all() and pop_n() prefetch.
+ * Wrapped in ringmaster::RingLayout it also fixes the ring's footprint:
+ * the index width, the padding of the indices and waiter flags, whether
+ * the waiting calls exist, and the alignment of the slot array. With a
+ * 32-bit index_type, sequence() wraps at 2^32.
+ *
+ * @note This class is NOT safe for multiple concurrent producers or consumers.
+ * @note A thread parked in pop_wait() is only woken by push_wait() or
+ * wakeConsumer(), and one parked in push_wait() only by pop_wait() or
+ * wakeProducer(); pair the blocking calls.
+ * @warning clear() is not thread-safe; only call when no push/pop is in flight.
+ */
+template<typename Q_TYPE,
+    size_t Capacity,
+    bool CacheIndices     = false,
+    typename WaitStrategy = ringmaster::HybridWait<>,
+    typename Stats        = ringmaster::NullStats,
+    typename Layout       = ringmaster::DenseLayout<>>
+class RingMaster {
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+
+  // Distance between physical slots, and whether slots form plain Q_TYPE arrays
+  static constexpr size_t SlotBytes  = Layout::template slot_bytes<Q_TYPE>;
+  static constexpr bool   Contiguous = Layout::contiguous && SlotBytes == sizeof(Q_TYPE);
+
+  // Footprint chosen by the layout (see ringmaster::RingLayout)
+  using Traits = ringmaster::detail::LayoutTraits<Layout>;
+  using Index  = typename Traits::index_type;
+
+  static constexpr size_t Padding = Traits::padding;
+  static constexpr bool   Waiting = Traits::waiting;
+
+  // Largest capacity whose fill level still fits in Index
+  static constexpr size_t MaxCapacity = size_t(1) << (std::numeric_limits<Index>::digits - 1);
+  static_assert(Capacity <= MaxCapacity, "Capacity is too large for the layout's index type");
+
+public:
+  /**
+   * @brief Default number of elements handled by one consume_all() call
+   *
+   * Half of the L1 data cache worth of elements (at least one), so a batch
+   * can be visited without evicting itself or the consumer's other data.
+   */
+  static constexpr size_t DefaultBatch =
+      std::max<size_t>(ringmaster::Hardware::l1d / 2 / sizeof(Q_TYPE), 1);
+
+  /**
+   * @struct Segments
+   * @brief View of up to two contiguous runs of slots inside buffer_
+   *
+   * Returned by try_claim(), peek() and peek_from(). `first` starts at the
+   * requested index; `second` is non-empty only when the run wraps past the
+   * end of buffer_ and continues at slot 0.
+   */
+  struct Segments {
+    std::span<Q_TYPE> first;  /**< Slots up to the wrap point */
+    std::span<Q_TYPE> second; /**< Remaining slots from the start of buffer_ */
+
+    size_t size() const noexcept { return first.size() + second.size(); }
+    bool   empty() const noexcept { return first.empty(); }
+
+    Q_TYPE &operator[](size_t i) const noexcept {
+      return (i < first.size()) ? first[i] : second[i - first.size()];
+    }
+  };
+
+private:
+  /**
+   * @brief Placeholder for a disabled member
+   *
+   * One type per member, so that the empty members can share addresses
+   * with the rest of the ring instead of each taking a byte of its own.
+   */
+  template<int Member> struct Nothing {};
+
+  template<typename T> using Padded = ringmaster::detail::Padded<T, Padding>;
+
+  using PaddedAtomic = Padded<std::atomic<Index>>;
+  using Flag         = Padded<std::atomic<uint32_t>>;
+
+  template<int Member>
+  using PaddedFlag = std::conditional_t<Waiting, Flag, Nothing<Member>>;
+  template<int Member>
+  using CachedIndex = std::conditional_t<CacheIndices, Padded<Index>, Nothing<Member>>;
+
+  using Storage =
+      ringmaster::detail::RingStorage<Q_TYPE, Capacity, SlotBytes, Traits::slot_alignment>;
+
+  // Slots come first so that a large slot alignment leaves no gap before
+  // them, and the indices may reuse the tail padding of the inline array
+  [[no_unique_address]] Storage storage_; /**< Storage for elements */
+  PaddedAtomic head_{0}; /**< Producer index (next write position) */
+  PaddedAtomic tail_{0}; /**< Consumer index (next read position) */
+  [[no_unique_address]] CachedIndex<0> tail_cache_{}; /**< Producer's copy of tail_ */
+  [[no_unique_address]] CachedIndex<1> head_cache_{}; /**< Consumer's copy of head_ */
+
+  /**
+   * @brief Adaptive blocking primitives (spin-then-block)
+   *
+   * These members provide a low-overhead mechanism to block the producer
+   * or consumer when waits become long. The strategy is:
+   *  1. Busy-spin for a short number of iterations to cover common short
+   *     wait periods (keeps latency low for brief stalls).
+   *  2. If spinning exceeds a threshold, raise the side's waiter flag and
+   *     park on it with std::atomic::wait until the opposite side clears it.
+   *
+   * The opposite side only touches the kernel when it finds the flag raised,
+   * so the hot path of push_wait()/pop_wait() never issues a notify syscall.
+   * Only one thread ever parks on each flag, which preserves the
+   * single-producer / single-consumer assumptions of the ring. Layouts
+   * that disable waiting replace the flags with empty placeholders.
+   */
+  [[no_unique_address]] PaddedFlag<2> consumer_waiting_{}; /**< Raised by pop_wait() while empty */
+  [[no_unique_address]] PaddedFlag<3> producer_waiting_{}; /**< Raised by push_wait() while full */
+  [[no_unique_address]] PaddedFlag<4> closed_{};           /**< Set by close() */
+
+  [[no_unique_address]] Stats stats_{}; /**< Statistics policy; empty for NullStats */
+
+  /**
+   * @brief Park on `flag` unless `ready()` already holds, at most until `deadline`
+   *
+   * The flag is raised before the ring state is re-checked, and the fence
+   * pairs with the one in wake(): either this thread observes the opposite
+   * side's index update, or wake() observes the raised flag. This closes the
+   * lost-wakeup window without a mutex. Returns after a wake-up, at the
+   * deadline, or spuriously; callers retry their operation afterwards.
+   */
+  template<typename READY, typename DEADLINE>
+  static void park(Flag &flag, READY &&ready, const DEADLINE &deadline) noexcept {
+    flag.var.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!ready()) {
+      if constexpr (std::is_same_v<DEADLINE, ringmaster::detail::NoDeadline>) {
+        ringmaster::detail::park_word(flag.var, 1);
+      } else {
+        using std::chrono::duration_cast, std::chrono::nanoseconds;
+        ringmaster::detail::park_word_for(
+            flag.var, 1, duration_cast<nanoseconds>(deadline - DEADLINE::clock::now()));
+      }
+    }
+    flag.var.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Whether `deadline` has passed; never for NoDeadline
+   */
+  template<typename DEADLINE> static bool expired(const DEADLINE &deadline) noexcept {
+    if constexpr (std::is_same_v<DEADLINE, ringmaster::detail::NoDeadline>) {
+      return false;
+    } else {
+      return DEADLINE::clock::now() >= deadline;
+    }
+  }
+
+  /**
+   * @brief Release a thread parked on `flag`, if any
+   *
+   * Called after publishing an index update. The notify is skipped entirely
+   * when no waiter has raised the flag.
+   */
+  static void wake(Flag &flag) noexcept {
+    if constexpr (!WaitStrategy::parks) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (flag.var.load(std::memory_order_relaxed) &&
+        flag.var.exchange(0, std::memory_order_relaxed)) {
+      ringmaster::detail::wake_word(flag.var);
+    }
+  }
+
+  /**
+   * @brief Number of positions from `from` up to `to`, modulo the index range
+   *
+   * Indices are loaded into size_t but wrap at the width of Index, so every
+   * difference is taken in Index arithmetic.
+   */
+  static size_t distance(size_t to, size_t from) noexcept { return static_cast<Index>(to - from); }
+
+  /**
+   * @brief Free slots as seen by the producer
+   *
+   * Without CacheIndices this always performs an acquire load of tail_. With
+   * CacheIndices the cached copy is trusted while it reports at least `want`
+   * free slots, and tail_ is only reloaded when it does not.
+   *
+   * @param head Current producer index (owned by the caller)
+   * @param want Number of free slots the caller needs
+   * @return Number of free slots (may exceed or fall short of `want`)
+   */
+  size_t writable(size_t head, size_t want = 1) noexcept {
+    if constexpr (CacheIndices) {
+      size_t space = capacity() - distance(head, tail_cache_.var);
+      if (space >= want) return space;
+      tail_cache_.var = tail_.var.load(std::memory_order_acquire);
+      return capacity() - distance(head, tail_cache_.var);
+    } else {
+      return capacity() - distance(head, tail_.var.load(std::memory_order_acquire));
+    }
+  }
+
+  /**
+   * @brief Filled slots as seen by the consumer
+   *
+   * Mirror image of writable(): with CacheIndices, head_ is only reloaded
+   * when the cached copy reports fewer than `want` elements.
+   *
+   * @param tail Current consumer index (owned by the caller)
+   * @param want Number of elements the caller needs
+   * @return Number of elements available to read
+   */
+  size_t readable(size_t tail, size_t want = 1) noexcept {
+    if constexpr (CacheIndices) {
+      size_t avail = distance(head_cache_.var, tail);
+      if (avail >= want) return avail;
+      head_cache_.var = head_.var.load(std::memory_order_acquire);
+      return distance(head_cache_.var, tail);
+    } else {
+      return distance(head_.var.load(std::memory_order_acquire), tail);
+    }
+  }
+
+  /**
+   * @brief Copy `len` elements from `src` into contiguous empty slots at `dst`
+   *
+   * Trivially copyable elements coming from a contiguous range are copied
+   * with a single detail::bulk_copy() (streaming stores for very large
+   * batches); everything else is constructed element by element.
+   *
+   * @return Iterator one past the last element consumed from `src`
+   */
+  template<typename IT> static IT copy_in(Q_TYPE *dst, IT src, size_t len) noexcept {
+    using SRC_TYPE = std::remove_cv_t<typename std::iterator_traits<IT>::value_type>;
+    if constexpr (std::is_trivially_copyable_v<Q_TYPE> && std::contiguous_iterator<IT> &&
+                  std::is_same_v<SRC_TYPE, Q_TYPE>) {
+      if (len) ringmaster::detail::bulk_copy(dst, std::to_address(src), len * sizeof(Q_TYPE));
+      return src + len;
+    } else {
+      for (size_t i = 0; i < len; ++i, ++src) std::construct_at(dst + i, *src);
+      return src;
+    }
+  }
+
+  /**
+   * @brief Move `len` elements out of contiguous slots at `src` into `dst`
+   *
+   * Counterpart of copy_in(); uses a single memcpy when the destination is
+   * a contiguous range of trivially copyable Q_TYPE. Never streams: the
+   * destination is the consumer's own buffer, which it is about to read, so
+   * bypassing the cache would only evict the lines it needs next. The
+   * source elements are destroyed, leaving the slots empty.
+   *
+   * @return Iterator one past the last element written to `dst`
+   */
+  template<typename OUT_IT> static OUT_IT copy_out(OUT_IT dst, Q_TYPE *src, size_t len) noexcept {
+    if constexpr (std::is_trivially_copyable_v<Q_TYPE> && std::contiguous_iterator<OUT_IT> &&
+                  std::is_same_v<typename std::iterator_traits<OUT_IT>::value_type, Q_TYPE>) {
+      if (len) std::memcpy(std::to_address(dst), src, len * sizeof(Q_TYPE));
+      return dst + len;
+    } else {
+      for (size_t i = 0; i < len; ++i, ++dst) {
+        *dst = std::move(src[i]);
+        std::destroy_at(src + i);
+      }
+      return dst;
+    }
+  }
+
+  /**
+   * @brief Split `n` slots starting at logical index `index` at the wrap point
+   */
+  Segments segments(size_t index, size_t n) noexcept {
+    Q_TYPE      *buffer    = storage_.data();
+    const size_t idx       = index & storage_.mask();
+    const size_t first_len = (n > capacity() - idx) ? capacity() - idx : n;
+    return {std::span<Q_TYPE>(buffer + idx, first_len), std::span<Q_TYPE>(buffer, n - first_len)};
+  }
+
+  /**
+   * @brief Slot holding logical index `index`, as placed by Layout
+   */
+  Q_TYPE *slot(size_t index) noexcept {
+    return storage_.slot(Layout::template position<Q_TYPE>(index, storage_.mask()));
+  }
+
+  /**
+   * @brief Prefetch the slot Layout::prefetch places ahead of `index`
+   *
+   * Only slots already published (within `avail` of `index`) are touched,
+   * so the consumer never pulls in a line the producer is still writing.
+   */
+  void prefetch(size_t index, size_t avail) noexcept {
+    if constexpr (Layout::prefetch != 0) {
+      if (avail > Layout::prefetch) ringmaster::prefetch_read(slot(index + Layout::prefetch));
+    }
+  }
+
+  /**
+   * @brief Destroy the `n` live elements starting at logical index `index`
+   *
+   * Compiles to nothing for trivially destructible Q_TYPE.
+   */
+  void destroy(size_t index, size_t n) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<Q_TYPE>) {
+      if constexpr (Contiguous) {
+        const Segments seg = segments(index, n);
+        std::destroy(seg.first.begin(), seg.first.end());
+        std::destroy(seg.second.begin(), seg.second.end());
+      } else {
+        for (size_t i = 0; i < n; ++i) std::destroy_at(slot(index + i));
+      }
+    }
+  }
+
+public:
+  /**
+   * @brief Default constructor initializes indices
+   *
+   * head_ and tail_ start at zero, indicating an empty buffer.
+   */
+  RingMaster() noexcept = default;
+
+  /**
+   * @brief Construct a ring whose capacity is chosen at runtime
+   *
+   * Only available when Capacity is ringmaster::DynamicCapacity.
+   *
+   * @param capacity Number of slots; must be a non-zero power of two
+   * @param pages Page backing for the slot array
+   * @param numa_node NUMA node to bind the slot array to (best effort), or
+   * ringmaster::AnyNumaNode
+   * @throws std::invalid_argument if capacity is not a power of two or is
+   * too large for the layout's index type
+   * @throws std::bad_alloc if the storage cannot be allocated
+   */
+  explicit RingMaster(size_t capacity,
+      ringmaster::HugePages  pages     = ringmaster::HugePages::None,
+      int                    numa_node = ringmaster::AnyNumaNode)
+    requires(Capacity == ringmaster::DynamicCapacity)
+      : storage_((capacity <= MaxCapacity)
+                ? capacity
+                : throw std::invalid_argument("RingMaster capacity exceeds the index range"),
+            pages, numa_node) {}
+
+  /**
+   * @brief Destructor cleans up resources
+   *
+   * Destroys the elements still in the ring. Compile-time sized rings use no
+   * dynamic allocation; runtime-sized rings release their slot storage.
+   */
+  ~RingMaster() { clear(); }
+
+  // Non-copyable, non-movable
+  RingMaster(const RingMaster &)            = delete;
+  RingMaster &operator=(const RingMaster &) = delete;
+
+  /**
+   * @brief Construct an element directly in the next free slot
+   *
+   * No temporary is created: `args` are forwarded to Q_TYPE's constructor,
+   * which runs on the slot itself. head_ is published afterwards.
+   *
+   * @tparam ARGS Constructor argument types
+   * @param args Arguments forwarded to the Q_TYPE constructor
+   * @return true if insertion succeeded, false if buffer was full
+   */
+  template<typename... ARGS> bool emplace(ARGS &&...args) noexcept {
+    const size_t head = head_.var.load(std::memory_order_relaxed);
+
+    if (writable(head) == 0) { // buffer full
+      stats_.fullHit();
+      return false;
+    }
+
+    std::construct_at(slot(head), std::forward<ARGS>(args)...);
+
+    // Use release ordering to ensure the data write is visible before the head update
+    head_.var.store(head + 1, std::memory_order_release);
+    stats_.pushed(1);
+    return true;
+  }
+
+  /**
+   * @brief Push an element into the ring buffer if space is available
+   *
+   * Move- or copy-constructs the element in its slot via emplace().
+   * Employs perfect forwarding to accept lvalues or rvalues efficiently.
+   *
+   * @tparam ENQ_TYPE Type deduced for insertion (Q_TYPE must be
+   * constructible from it)
+   * @param value Element to insert (forwarded)
+   * @return true if insertion succeeded, false if buffer was full
+   */
+  template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept {
+    return emplace(std::forward<ENQ_TYPE>(value));
+  }
+
+  /**
+   * @brief Pop the oldest element from the buffer
+   *
+   * Moves the element at tail_ into `out`, destroys it in its slot, then
+   * advances tail_.
+   *
+   * @param out Reference where the popped element is stored
+   * @return true if an element was available, false if buffer was empty
+   */
+  bool pop(Q_TYPE &out) noexcept {
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail);
+
+    if (avail == 0) { // buffer empty
+      stats_.emptyHit();
+      return false;
+    }
+
+    prefetch(tail, avail);
+    Q_TYPE *elem = slot(tail);
+    out          = std::move(*elem);
+    std::destroy_at(elem);
+
+    // Use release ordering to ensure data read completes before tail update
+    tail_.var.store(tail + 1, std::memory_order_release);
+    stats_.popped(1);
+    return true;
+  }
+
+  /**
+   * @brief Pop the oldest element by value
+   *
+   * Unlike pop(Q_TYPE &), the caller needs no default-constructed element
+   * to receive the value.
+   *
+   * @return The element, or std::nullopt if the buffer was empty
+   */
+  std::optional<Q_TYPE> pop() noexcept {
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail);
+
+    if (avail == 0) { // buffer empty
+      stats_.emptyHit();
+      return std::nullopt;
+    }
+
+    prefetch(tail, avail);
+    Q_TYPE               *elem = slot(tail);
+    std::optional<Q_TYPE> out(std::move(*elem));
+    std::destroy_at(elem);
+
+    // Use release ordering to ensure data read completes before tail update
+    tail_.var.store(tail + 1, std::memory_order_release);
+    stats_.popped(1);
+    return out;
+  }
+
+  /**
+   * @brief Invoke `visitor` on the oldest element in place, then retire it
+   *
+   * The element is neither moved nor copied out: `visitor` receives a
+   * reference to the slot (it may move from it), after which the element is
+   * destroyed and tail_ advances.
+   *
+   * @tparam F Callable accepting Q_TYPE &; must not throw
+   * @param visitor Called with the oldest element
+   * @return true if an element was consumed, false if buffer was empty
+   */
+  template<typename F> bool consume(F &&visitor) noexcept {
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail);
+
+    if (avail == 0) { // buffer empty
+      stats_.emptyHit();
+      return false;
+    }
+
+    prefetch(tail, avail);
+    Q_TYPE *elem = slot(tail);
+    visitor(*elem);
+    std::destroy_at(elem);
+
+    // Use release ordering so the visitor's reads complete before tail_ moves
+    tail_.var.store(tail + 1, std::memory_order_release);
+    stats_.popped(1);
+    return true;
+  }
+
+  /**
+   * @brief Invoke `visitor` on up to `max` of the oldest elements in place
+   *
+   * Visits every element that was available when the call started, oldest
+   * first, then releases all of their slots with a single release store of
+   * tail_.
+   *
+   * @tparam F Callable accepting Q_TYPE &; must not throw
+   * @param visitor Called once per element
+   * @param max Maximum number of elements to consume (default DefaultBatch)
+   * @return Number of elements consumed (0 if the buffer was empty or `max`
+   * was 0)
+   */
+  template<typename F> size_t consume_all(F &&visitor, size_t max = DefaultBatch) noexcept {
+    if (max == 0) return 0; // no budget: not an empty hit
+
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail, max);
+    const size_t n     = (max > avail) ? avail : max;
+
+    if (n == 0) { // buffer empty
+      stats_.emptyHit();
+      return 0;
+    }
+
+    if constexpr (Contiguous && Layout::prefetch == 0) {
+      const Segments seg = segments(tail, n);
+      for (Q_TYPE &elem : seg.first) visitor(elem);
+      for (Q_TYPE &elem : seg.second) visitor(elem);
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        prefetch(tail + i, n - i);
+        visitor(*slot(tail + i));
+      }
+    }
+    destroy(tail, n);
+
+    // One release store frees the whole batch
+    tail_.var.store(tail + n, std::memory_order_release);
+    stats_.popped(n);
+    return n;
+  }
+
+  /**
+   * @brief Push up to `count` elements from an input range
+   *
+   * Copies as many elements as fit, splitting the write into at most two
+   * contiguous segments around the wrap point, then publishes all of them
+   * with a single release store of head_. Pass a std::move_iterator to move
+   * elements instead of copying them.
+   *
+   * @tparam IT Input iterator whose elements are assignable to Q_TYPE
+   * @param first Iterator to the first element to push
+   * @param count Maximum number of elements to push
+   * @return Number of elements actually pushed (0 if the buffer was full or
+   * `count` was 0)
+   */
+  template<typename IT> size_t push_n(IT first, size_t count) noexcept {
+    if (count == 0) return 0; // nothing to push: not a full hit
+
+    const size_t head  = head_.var.load(std::memory_order_relaxed);
+    const size_t space = writable(head, count);
+    const size_t n     = (count > space) ? space : count;
+
+    if (n == 0) { // buffer full
+      stats_.fullHit();
+      return 0;
+    }
+
+    if constexpr (Contiguous) {
+      const Segments seg = segments(head, n);
+      first              = copy_in(seg.first.data(), first, seg.first.size());
+      copy_in(seg.second.data(), first, seg.second.size());
+    } else {
+      for (size_t i = 0; i < n; ++i, ++first) std::construct_at(slot(head + i), *first);
+    }
+
+    // One release store publishes the whole batch
+    head_.var.store(head + n, std::memory_order_release);
+    stats_.pushed(n);
+    return n;
+  }
+
+  /**
+   * @brief Push up to `items.size()` elements from a contiguous range
+   *
+   * @param items Elements to copy into the buffer
+   * @return Number of elements actually pushed
+   */
+  size_t push_n(std::span<const Q_TYPE> items) noexcept {
+    return push_n(items.begin(), items.size());
+  }
+
+  /**
+   * @brief Pop up to `count` of the oldest elements into an output range
+   *
+   * Moves the elements out in at most two contiguous segments and releases
+   * all of the slots with a single release store of tail_.
+   *
+   * @tparam OUT_IT Output iterator accepting Q_TYPE rvalues
+   * @param dst Iterator to the first destination element
+   * @param count Maximum number of elements to pop
+   * @return Number of elements actually popped (0 if the buffer was empty or
+   * `count` was 0)
+   */
+  template<typename OUT_IT> size_t pop_n(OUT_IT dst, size_t count) noexcept {
+    if (count == 0) return 0; // no room: not an empty hit
+
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail, count);
+    const size_t n     = (count > avail) ? avail : count;
+
+    if (n == 0) { // buffer empty
+      stats_.emptyHit();
+      return 0;
+    }
+
+    if constexpr (Contiguous && Layout::prefetch == 0) {
+      const Segments seg = segments(tail, n);
+      dst                = copy_out(dst, seg.first.data(), seg.first.size());
+      copy_out(dst, seg.second.data(), seg.second.size());
+    } else {
+      for (size_t i = 0; i < n; ++i, ++dst) {
+        prefetch(tail + i, n - i);
+        Q_TYPE *elem = slot(tail + i);
+        *dst         = std::move(*elem);
+        std::destroy_at(elem);
+      }
+    }
+
+    // One release store frees the whole batch
+    tail_.var.store(tail + n, std::memory_order_release);
+    stats_.popped(n);
+    return n;
+  }
+
+  /**
+   * @brief Pop up to `out.size()` elements into a contiguous range
+   *
+   * @param out Destination storage
+   * @return Number of elements actually popped
+   */
+  size_t pop_n(std::span<Q_TYPE> out) noexcept { return pop_n(out.begin(), out.size()); }
+
+  /**
+   * @brief Reserve up to `n` slots for in-place writing
+   *
+   * Returns spans pointing straight into buffer_ so the producer can build
+   * elements in their final location. The slots are empty: trivially
+   * copyable elements may simply be written, anything else must be
+   * constructed with std::construct_at() (or placement new) before commit().
+   * Nothing becomes visible to the consumer until commit() is called.
+   * Calling try_claim() again before commit() returns the same slots.
+   *
+   * Only available when Layout stores slots as a plain Q_TYPE array.
+   *
+   * @param n Maximum number of slots wanted
+   * @return Writable slots (empty if the buffer is full)
+   */
+  Segments try_claim(size_t n) noexcept
+    requires(Contiguous)
+  {
+    const size_t head  = head_.var.load(std::memory_order_relaxed);
+    const size_t space = writable(head, n);
+    return segments(head, (n > space) ? space : n);
+  }
+
+  /**
+   * @brief Publish the first `n` slots returned by try_claim()
+   *
+   * @param n Number of slots to publish; must not exceed the claimed size
+   */
+  void commit(size_t n) noexcept {
+    const size_t head = head_.var.load(std::memory_order_relaxed);
+    // Use release ordering so the in-place writes are visible before head_
+    head_.var.store(head + n, std::memory_order_release);
+    stats_.pushed(n);
+  }
+
+  /**
+   * @brief Access up to `n` of the oldest elements in place
+   *
+   * The consumer may read, modify or move from the returned elements; the
+   * slots stay owned by the consumer until release() destroys the elements
+   * and hands the slots back to the producer.
+   *
+   * Only available when Layout stores slots as a plain Q_TYPE array.
+   *
+   * @param n Maximum number of elements wanted
+   * @return Readable elements, oldest first (empty if the buffer is empty)
+   */
+  Segments peek(size_t n = SIZE_MAX) noexcept
+    requires(Contiguous)
+  {
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail, n);
+    return segments(tail, (n > avail) ? avail : n);
+  }
+
+  /**
+   * @brief Return the first `n` slots obtained from peek() to the producer
+   *
+   * @param n Number of elements consumed; must not exceed the peeked size
+   */
+  void release(size_t n) noexcept {
+    const size_t tail = tail_.var.load(std::memory_order_relaxed);
+    destroy(tail, n);
+    // Use release ordering so in-place reads complete before tail_ moves
+    tail_.var.store(tail + n, std::memory_order_release);
+    stats_.popped(n);
+  }
+
+  /**
+   * @brief Discard up to n oldest elements without retrieval
+   *
+   * Destroys up to n elements and advances tail_ past them.
+   *
+   * @param n Maximum number of elements to remove
+   * @return Actual number of elements removed
+   */
+  size_t remove(size_t n) noexcept {
+    const size_t tail     = tail_.var.load(std::memory_order_relaxed);
+    const size_t avail    = readable(tail, n);
+    const size_t toRemove = (n > avail) ? avail : n;
+
+    if (toRemove) {
+      destroy(tail, toRemove);
+      tail_.var.store(tail + toRemove, std::memory_order_release);
+      stats_.popped(toRemove);
+    }
+    return toRemove;
+  }
+
+  /**
+   * @brief Sequence number of the oldest element not yet acknowledged
+   *
+   * The position of an element is a sequence number that identifies it for
+   * its whole life: the n-th element ever pushed has sequence n - 1, modulo
+   * the range of the layout's index type. With the default size_t indices
+   * sequences never wrap in practice. With a 32-bit index_type (e.g.
+   * ringmaster::CompactLayout) they wrap at 2^32, so compare and subtract
+   * them modulo that width rather than with a plain `<`. peek_from() and
+   * acknowledge() do so, and accept sequences with any higher bits.
+   * Consumer only.
+   */
+  size_t sequence() const noexcept { return tail_.var.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Access up to `n` elements in place, starting at sequence `seq`
+   *
+   * Like peek(), but starts past elements the consumer has already looked
+   * at without acknowledging them, so a consumer can read ahead
+   * speculatively (or hand out consecutive ranges to workers) and then
+   * retire everything before a sequence with one acknowledge().
+   *
+   * Only available when Layout stores slots as a plain Q_TYPE array.
+   *
+   * @param seq First sequence wanted; at or after sequence(), modulo the
+   * index width
+   * @param n Maximum number of elements wanted
+   * @return Readable elements from `seq` on (empty if none are published)
+   */
+  Segments peek_from(size_t seq, size_t n = SIZE_MAX) noexcept
+    requires(Contiguous)
+  {
+    const size_t tail  = tail_.var.load(std::memory_order_relaxed);
+    const size_t skip  = distance(seq, tail);
+    const size_t want  = (n > SIZE_MAX - skip) ? SIZE_MAX : skip + n;
+    const size_t avail = readable(tail, want);
+    const size_t ahead = (avail > skip) ? avail - skip : 0;
+    return segments(seq, (n > ahead) ? ahead : n);
+  }
+
+  /**
+   * @brief Retire every element with a sequence number below `seq`
+   *
+   * Destroys the elements and publishes the new tail_ with a single
+   * release store, however many elements the batch covers.
+   *
+   * @param seq One past the last sequence consumed; at most the sequence
+   * after the last element returned by peek_from()
+   */
+  void acknowledge(size_t seq) noexcept {
+    release(distance(seq, tail_.var.load(std::memory_order_relaxed)));
+  }
+
+  /**
+   * @brief Reset buffer to empty state
+   *
+   * Destroys every element still in the ring, then sets both head_ and
+   * tail_ (and their cached copies) back to zero and reopens a closed ring.
+   *
+   * @warning Not thread-safe. Only call when no concurrent push/pop operations.
+   */
+  void clear() noexcept {
+    const size_t tail = tail_.var.load(std::memory_order_relaxed);
+    destroy(tail, distance(head_.var.load(std::memory_order_relaxed), tail));
+    head_.var.store(0, std::memory_order_relaxed);
+    tail_.var.store(0, std::memory_order_relaxed);
+    if constexpr (Waiting) closed_.var.store(0, std::memory_order_relaxed);
+    if constexpr (CacheIndices) {
+      tail_cache_.var = 0;
+      head_cache_.var = 0;
+    }
+  }
+
+  /**
+   * @brief Check if buffer is empty
+   *
+   * Compares head_ and tail_ atomically; may be slightly stale under
+   * concurrency.
+   *
+   * @return true if no elements are in the buffer, false otherwise.
+   */
+  bool isEmpty() const noexcept {
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    const size_t tail = tail_.var.load(std::memory_order_acquire);
+    return head == tail;
+  }
+
+  /**
+   * @brief Check if buffer is full
+   *
+   * True when advancing head_ would collide with tail_.
+   *
+   * @return true if no additional elements can be pushed, false otherwise.
+   */
+  bool isFull() const noexcept {
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    const size_t tail = tail_.var.load(std::memory_order_acquire);
+    return distance(head, tail) >= capacity();
+  }
+
+  /**
+   * @brief Number of slots in the ring
+   */
+  size_t capacity() const noexcept { return storage_.capacity(); }
+
+  /**
+   * @brief Whether the slot array got the huge page backing it asked for
+   *
+   * True for a MAP_HUGETLB mapping, or for a THP mapping whose MADV_HUGEPAGE
+   * advice the kernel accepted; with THP the kernel may still back parts of
+   * it with small pages. False for heap storage and for a THP mapping the
+   * kernel refused to advise.
+   */
+  bool usesHugePages() const noexcept { return storage_.huge_pages(); }
+
+  /**
+   * @brief NUMA node the slot array is bound to, or ringmaster::AnyNumaNode
+   */
+  int numaNode() const noexcept { return storage_.numa_node(); }
+
+  /**
+   * @brief Statistics policy instance, e.g. `stats().snapshot()` for CountingStats
+   */
+  const Stats &stats() const noexcept { return stats_; }
+
+  /**
+   * @brief Get approximate count of elements in buffer
+   *
+   * Computes difference between head_ and tail_; may be stale under heavy
+   * concurrency.
+   *
+   * @return Number of elements currently held in buffer
+   */
+  size_t size() const noexcept {
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    const size_t tail = tail_.var.load(std::memory_order_acquire);
+    return distance(head, tail);
+  }
+
+  /**
+   * @brief Push with adaptive spin-then-block waiting
+   *
+   * This call will attempt to push the supplied value into the ring. Between
+   * failed attempts it defers to WaitStrategy, which by default spins with a
+   * PAUSE hint for up to `spin_limit` attempts to keep latency low for short
+   * waits. If the strategy gives up, the thread parks until pop_wait() frees
+   * a slot.
+   *
+   * @tparam ENQ_TYPE Deduced type for the value to insert
+   * @param value Value to insert (forwarded)
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true once the value is pushed, false if the ring was found full
+   * after close()
+   */
+  template<typename ENQ_TYPE>
+  bool push_wait(ENQ_TYPE &&value, size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return push_until(std::forward<ENQ_TYPE>(value), spin_limit, ringmaster::detail::NoDeadline{});
+  }
+
+  /**
+   * @brief push_wait() that gives up at `deadline`
+   *
+   * Spins exactly like push_wait(), then parks on a futex with a timeout.
+   *
+   * @param value Value to insert (forwarded); left untouched on failure
+   * @param deadline Time point after which the call fails
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true if the value was pushed, false on timeout or close()
+   */
+  template<typename ENQ_TYPE, typename CLOCK, typename DURATION>
+  bool try_push_until(ENQ_TYPE &&value,
+      const std::chrono::time_point<CLOCK, DURATION> &deadline,
+      size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return push_until(std::forward<ENQ_TYPE>(value), spin_limit, deadline);
+  }
+
+  /**
+   * @brief push_wait() that gives up after `timeout`
+   *
+   * @return true if the value was pushed, false on timeout or close()
+   */
+  template<typename ENQ_TYPE, typename REP, typename PERIOD>
+  bool try_push_for(ENQ_TYPE &&value,
+      const std::chrono::duration<REP, PERIOD> &timeout,
+      size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return push_until(
+        std::forward<ENQ_TYPE>(value), spin_limit, std::chrono::steady_clock::now() + timeout);
+  }
+
+  /**
+   * @brief Pop with adaptive spin-then-block waiting
+   *
+   * Symmetric to push_wait(): waits between failed attempts as directed by
+   * WaitStrategy, then parks until push_wait() publishes an element.
+   *
+   * @param out Reference that receives the popped element
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true on successful pop, false once the ring is closed and
+   * drained
+   */
+  bool pop_wait(Q_TYPE &out, size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return pop_until(out, spin_limit, ringmaster::detail::NoDeadline{});
+  }
+
+  /**
+   * @brief pop_wait() into an optional, for elements without a default constructor
+   *
+   * @param out Receives the popped element; left empty on failure
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true on successful pop, false once the ring is closed and
+   * drained
+   */
+  bool pop_wait(std::optional<Q_TYPE> &out, size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return pop_until(out, spin_limit, ringmaster::detail::NoDeadline{});
+  }
+
+  /**
+   * @brief pop_wait() that gives up at `deadline`
+   *
+   * @param out Reference that receives the popped element
+   * @param deadline Time point after which the call fails
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true on successful pop, false on timeout or once the ring is
+   * closed and drained
+   */
+  template<typename CLOCK, typename DURATION>
+  bool try_pop_until(Q_TYPE &out,
+      const std::chrono::time_point<CLOCK, DURATION> &deadline,
+      size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return pop_until(out, spin_limit, deadline);
+  }
+
+  /**
+   * @brief pop_wait() that gives up after `timeout`
+   *
+   * @return true on successful pop, false on timeout or once the ring is
+   * closed and drained
+   */
+  template<typename REP, typename PERIOD>
+  bool try_pop_for(Q_TYPE &out,
+      const std::chrono::duration<REP, PERIOD> &timeout,
+      size_t spin_limit = 1024) noexcept
+    requires(Waiting)
+  {
+    return pop_until(out, spin_limit, std::chrono::steady_clock::now() + timeout);
+  }
+
+  /**
+   * @brief Make every waiting call return instead of waiting
+   *
+   * Wakes a parked producer and consumer immediately. From then on a
+   * waiting push fails as soon as it finds the ring full, and a waiting pop
+   * fails once the ring is empty, so the consumer can still drain what was
+   * pushed before close(). The non-waiting calls are unaffected, and the
+   * hot path never reads the flag.
+   */
+  void close() noexcept
+    requires(Waiting)
+  {
+    // Release ordering so a consumer that sees the flag also sees every
+    // element pushed before it
+    closed_.var.store(1, std::memory_order_release);
+    wake(consumer_waiting_);
+    wake(producer_waiting_);
+  }
+
+  /**
+   * @brief Wake a consumer parked in pop_wait(), if any
+   *
+   * Lets a producer using the non-waiting push(), push_n() or commit()
+   * pair with a waiting consumer. Costs a fence and a load when nobody is
+   * parked.
+   */
+  void wakeConsumer() noexcept
+    requires(Waiting)
+  {
+    wake(consumer_waiting_);
+  }
+
+  /**
+   * @brief Wake a producer parked in push_wait(), if any
+   *
+   * Counterpart of wakeConsumer() for a consumer using the non-waiting pops.
+   */
+  void wakeProducer() noexcept
+    requires(Waiting)
+  {
+    wake(producer_waiting_);
+  }
 
-#ifndef CACHE_LINE_SIZE
-#define CACHE_LINE_SIZE 64 // Default cache line size in bytes
-#endif
+  /**
+   * @brief Whether close() has been called (since the last clear())
+   */
+  bool isClosed() const noexcept
+    requires(Waiting)
+  {
+    return closed_.var.load(std::memory_order_acquire) != 0;
+  }
+
+private:
+  // Failed attempts between two checks of close() and the deadline while
+  // spinning, so the spin loop neither reads the clock nor the flag's line
+  // on every attempt (the same amortisation as HybridWait)
+  static constexpr size_t StopCheckInterval = 64;
+
+  /**
+   * @brief Whether a waiting call should look at close() and its deadline
+   *
+   * True every StopCheckInterval failed attempts, and always once the
+   * strategy stops spinning, before the thread would park.
+   */
+  static bool check_stop(size_t spins, bool spinning) noexcept {
+    return !spinning || (spins % StopCheckInterval) == 0;
+  }
+
+  /**
+   * @brief Shared body of push_wait() and the timed pushes
+   */
+  template<typename ENQ_TYPE, typename DEADLINE>
+  bool push_until(ENQ_TYPE &&value, size_t spin_limit, const DEADLINE &deadline) noexcept {
+    // Local accumulator so the stats policy is updated once per call; dead
+    // code with NullStats.
+    size_t       local_spins = 0;
+    WaitStrategy waiter(spin_limit);
+
+    // Try until push succeeds. The fastpath uses the existing non-blocking
+    // push() which is optimized for the SPSC case.
+    while (true) {
+      if (push(std::forward<ENQ_TYPE>(value))) {
+        // Successful push: update statistics and notify the consumer.
+        if (local_spins) stats_.producerSpins(local_spins);
+        // Wake the consumer only if it is parked.
+        wake(consumer_waiting_);
+        return true;
+      }
+
+      // Let the strategy pause, back off or yield; keep trying while it
+      // allows.
+      ++local_spins;
+      const bool spinning = waiter.spin();
+      if (check_stop(local_spins, spinning) && (isClosed() || expired(deadline))) {
+        stats_.producerSpins(local_spins);
+        return false;
+      }
+      if (spinning) continue;
+
+      // The strategy gave up spinning: enter blocking wait.
+      stats_.producerSpins(local_spins);
+      stats_.producerParked();
+
+      // Park until not full (or closed). The ring state is re-checked after
+      // the flag is raised, so a pop that lands in between is never missed.
+      park(producer_waiting_, [this]() { return !isFull() || isClosed(); }, deadline);
+
+      // After wakeup, loop and attempt push again. Reset local spin counter
+      // and the strategy to account for spins after wakeup.
+      local_spins = 0;
+      waiter      = WaitStrategy(spin_limit);
+    }
+  }
+
+  /**
+   * @brief Pop into `out`, whichever of the two output forms it is
+   */
+  bool pop_into(Q_TYPE &out) noexcept { return pop(out); }
+
+  bool pop_into(std::optional<Q_TYPE> &out) noexcept {
+    out = pop();
+    return out.has_value();
+  }
+
+  /**
+   * @brief Shared body of pop_wait() and the timed pops
+   */
+  template<typename OUT, typename DEADLINE>
+  bool pop_until(OUT &out, size_t spin_limit, const DEADLINE &deadline) noexcept {
+    size_t       local_spins = 0;
+    WaitStrategy waiter(spin_limit);
+
+    while (true) {
+      if (pop_into(out)) {
+        if (local_spins) stats_.consumerSpins(local_spins);
+        // Wake the producer only if it is parked.
+        wake(producer_waiting_);
+        return true;
+      }
+
+      ++local_spins;
+      const bool spinning = waiter.spin();
+      if (check_stop(local_spins, spinning)) {
+        if (isClosed()) {
+          // The acquire load makes every push that preceded close() visible
+          stats_.consumerSpins(local_spins);
+          if (!pop_into(out)) return false;
+          wake(producer_waiting_);
+          return true;
+        }
+        if (expired(deadline)) {
+          stats_.consumerSpins(local_spins);
+          return false;
+        }
+      }
+      if (spinning) continue;
+
+      stats_.consumerSpins(local_spins);
+      stats_.consumerParked();
+      park(consumer_waiting_, [this]() { return !isEmpty() || isClosed(); }, deadline);
+      local_spins = 0;
+      waiter      = WaitStrategy(spin_limit);
+    }
+  }
+};
 
 /**
- * @class RingMaster
- * @brief Lock-free circular buffer for single-producer/single-consumer patterns
+ * @class SequencedRingMaster
+ * @brief Bounded multi-producer ring with per-slot sequence numbers
  *
- * RingMaster provides constant-time push and pop operations with minimal
- * latency. Internally, it uses two atomic counters (head_ and tail_) padded to
- * cache lines to prevent false sharing. The buffer array is also aligned
- * to 64-byte boundaries.
+ * Implements Dmitry Vyukov's bounded queue: every slot carries a sequence
+ * number that tells a producer whether the slot is free for position `pos`
+ * (seq == pos) and tells a consumer whether it holds the element for `pos`
+ * (seq == pos + 1). Producers claim positions with a CAS on head_ and never
+ * read tail_; consumers never read head_. With a single consumer the CAS on
+ * tail_ degenerates to a plain store.
  *
- * @note This class is NOT safe for multiple concurrent producers or consumers.
- * @warning clear() is not thread-safe; only call when no push/pop is in flight.
+ * Use the MPSCRingMaster and MPMCRingMaster aliases rather than this
+ * template directly.
+ *
+ * @tparam Q_TYPE Element type; must be movable without throwing
+ * @tparam Capacity Number of slots; must be a power of two
+ * @tparam MultiConsumer Whether several threads may call pop() concurrently
+ * @tparam WaitStrategy Policy used by push_wait()/pop_wait() between failed
+ * attempts (see ringmaster::HybridWait)
  */
-template<typename Q_TYPE, size_t Capacity> class RingMaster {
-  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of two");
+template<typename Q_TYPE,
+    size_t Capacity,
+    bool MultiConsumer,
+    typename WaitStrategy = ringmaster::HybridWait<>>
+class SequencedRingMaster {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+      "Capacity must be a power of two of at least 2");
 
   // Mask for wrap-around indexing
   static constexpr size_t Mask = Capacity - 1;
 
-private:
   /**
-   * @struct PaddedAtomic
-   * @brief Cache-aligned atomic counter to avoid false sharing
-   *
-   * Each atomic variable is padded to occupy its own cache line,
-   * preventing contention between threads operating on head_ and tail_.
+   * @struct Slot
+   * @brief Element storage plus the sequence number guarding it
    */
-  struct alignas(CACHE_LINE_SIZE) PaddedAtomic {
-    std::atomic<size_t> var; /**< Atomic index counter (head or tail) */
-    char pad[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)]; /**< Padding to complete cache
-                                                   line size */
+  struct Slot {
+    std::atomic<size_t> seq;   /**< Position this slot is ready for (see class docs) */
+    Q_TYPE              value; /**< Stored element */
   };
 
-  PaddedAtomic head_{0}; /**< Producer index (next write position) */
-  PaddedAtomic tail_{0}; /**< Consumer index (next read position) */
-  alignas(
-      CACHE_LINE_SIZE) Q_TYPE buffer_[Capacity]; /**< Storage for elements, cache-line aligned */
+  ringmaster::PaddedAtomic head_{}; /**< Next position to claim for writing */
+  ringmaster::PaddedAtomic tail_{}; /**< Next position to claim for reading */
+  alignas(CACHE_LINE_SIZE) Slot slots_[Capacity]; /**< Storage for elements */
 
-  /**
-   * @brief Adaptive blocking primitives (spin-then-block)
-   *
-   * These members provide a low-overhead mechanism to block the producer
-   * or consumer when waits become long. The strategy is:
-   *  1. Busy-spin for a short number of iterations to cover common short
-   *     wait periods (keeps latency low for brief stalls).
-   *  2. If spinning exceeds a threshold, enter a condition_variable wait to
-   *     yield the CPU until the opposite side signals progress.
-   *
-   * The implementation is careful to preserve the single-producer /
-   * single-consumer assumptions of the ring: only at most one thread will
-   * ever wait on the producer-side path and at most one on the consumer
-   * side. Using a mutex + condvar here simplifies correctness and avoids
-   * more complex lock-free blocking constructs.
-   */
-  mutable std::mutex      cv_mutex_;     /**< Mutex for condition variables */
-  std::condition_variable not_empty_cv_; /**< Notifies consumer when items arrive */
-  std::condition_variable not_full_cv_;  /**< Notifies producer when space freed */
+  ringmaster::EventCount not_empty_; /**< Consumers parked in pop_wait() */
+  ringmaster::EventCount not_full_;  /**< Producers parked in push_wait() */
 
 public:
   /**
-   * @brief Default constructor initializes indices
-   *
-   * head_ and tail_ start at zero, indicating an empty buffer.
-   */
-  RingMaster() noexcept = default;
-
-  /**
-   * @brief Destructor cleans up resources
-   *
-   * No dynamic allocation is used; default behavior suffices.
+   * @brief Initialize every slot as free for its first lap
    */
-  ~RingMaster() { clear(); }
+  SequencedRingMaster() noexcept {
+    for (size_t i = 0; i < Capacity; ++i) slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
 
   // Non-copyable, non-movable
-  RingMaster(const RingMaster &)            = delete;
-  RingMaster &operator=(const RingMaster &) = delete;
+  SequencedRingMaster(const SequencedRingMaster &)            = delete;
+  SequencedRingMaster &operator=(const SequencedRingMaster &) = delete;
 
   /**
-   * @brief Push an element into the ring buffer if space is available
-   *
-   * Uses atomic operations to update head position after storing the value.
-   * Employs perfect forwarding to accept lvalues or rvalues efficiently.
+   * @brief Push an element if space is available; safe from any thread
    *
    * @tparam ENQ_TYPE Type deduced for insertion (should match Q_TYPE or
    * convertible)
@@ -132,213 +2269,348 @@ public:
    * @return true if insertion succeeded, false if buffer was full
    */
   template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept {
-    const size_t head = head_.var.load(std::memory_order_relaxed);
-    const size_t tail = tail_.var.load(std::memory_order_acquire);
+    size_t pos = head_.var.load(std::memory_order_relaxed);
+    Slot  *slot;
 
-    if (head - tail >= Capacity) { // buffer full
-      return false;
+    while (true) {
+      slot             = &slots_[pos & Mask];
+      const size_t seq = slot->seq.load(std::memory_order_acquire);
+      const auto   dif = static_cast<std::ptrdiff_t>(seq - pos);
+
+      if (dif == 0) {
+        if (head_.var.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (dif < 0) { // slot still holds the element from the previous lap
+        return false;
+      } else { // another producer claimed pos; catch up
+        pos = head_.var.load(std::memory_order_relaxed);
+      }
     }
 
-    buffer_[head & Mask] = std::forward<ENQ_TYPE>(value);
+    slot->value = std::forward<ENQ_TYPE>(value);
 
-    // Use release ordering to ensure the data write is visible before the head update
-    head_.var.store(head + 1, std::memory_order_release);
+    // Release ordering publishes the element to the consumer of this slot
+    slot->seq.store(pos + 1, std::memory_order_release);
     return true;
   }
 
   /**
-   * @brief Pop the oldest element from the buffer
+   * @brief Pop the oldest element
    *
-   * Retrieves the element at tail_, moves it into `out`, then advances tail_.
+   * Safe from any thread when MultiConsumer is true; otherwise only one
+   * thread may call pop().
    *
    * @param out Reference where the popped element is stored
    * @return true if an element was available, false if buffer was empty
    */
   bool pop(Q_TYPE &out) noexcept {
-    const size_t tail = tail_.var.load(std::memory_order_relaxed);
-    const size_t head = head_.var.load(std::memory_order_acquire);
+    size_t pos = tail_.var.load(std::memory_order_relaxed);
+    Slot  *slot;
 
-    if (head == tail) { // buffer empty
-      return false;
+    while (true) {
+      slot             = &slots_[pos & Mask];
+      const size_t seq = slot->seq.load(std::memory_order_acquire);
+      const auto   dif = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+
+      if (dif == 0) {
+        if constexpr (MultiConsumer) {
+          if (tail_.var.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        } else {
+          tail_.var.store(pos + 1, std::memory_order_relaxed);
+          break;
+        }
+      } else if (dif < 0) { // element for pos not published yet
+        return false;
+      } else { // another consumer took pos; catch up
+        pos = tail_.var.load(std::memory_order_relaxed);
+      }
     }
 
-    out = std::move(buffer_[tail & Mask]);
+    out = std::move(slot->value);
 
-    // Use release ordering to ensure data read completes before tail update
-    tail_.var.store(tail + 1, std::memory_order_release);
+    // Release ordering hands the slot to the producer of the next lap
+    slot->seq.store(pos + Capacity, std::memory_order_release);
     return true;
   }
 
   /**
-   * @brief Discard up to n oldest elements without retrieval
-   *
-   * Advances tail_ by up to n positions, effectively removing elements.
+   * @brief Push, waiting according to WaitStrategy while the ring is full
    *
-   * @param n Maximum number of elements to remove
-   * @return Actual number of elements removed
+   * @param value Value to insert (forwarded)
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
    */
-  size_t remove(size_t n) noexcept {
-    const size_t tail     = tail_.var.load(std::memory_order_relaxed);
-    const size_t head     = head_.var.load(std::memory_order_acquire);
-    const size_t avail    = head - tail;
-    const size_t toRemove = (n > avail) ? avail : n;
-
-    if (toRemove) {
-      tail_.var.store(tail + toRemove, std::memory_order_release);
+  template<typename ENQ_TYPE> void push_wait(ENQ_TYPE &&value, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (!push(std::forward<ENQ_TYPE>(value))) {
+      if (waiter.spin()) continue;
+      not_full_.wait_until([this]() { return !isFull(); });
+      waiter = WaitStrategy(spin_limit);
     }
-    return toRemove;
+    if constexpr (WaitStrategy::parks) not_empty_.notify_all();
   }
 
   /**
-   * @brief Reset buffer to empty state
-   *
-   * Sets both head_ and tail_ back to zero.
+   * @brief Pop, waiting according to WaitStrategy while the ring is empty
    *
-   * @warning Not thread-safe. Only call when no concurrent push/pop operations.
+   * @param out Reference that receives the popped element
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true on successful pop (always returns true eventually)
    */
-  void clear() noexcept {
-    head_.var.store(0, std::memory_order_relaxed);
-    tail_.var.store(0, std::memory_order_relaxed);
+  bool pop_wait(Q_TYPE &out, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (!pop(out)) {
+      if (waiter.spin()) continue;
+      not_empty_.wait_until([this]() { return !isEmpty(); });
+      waiter = WaitStrategy(spin_limit);
+    }
+    if constexpr (WaitStrategy::parks) not_full_.notify_all();
+    return true;
   }
 
   /**
-   * @brief Check if buffer is empty
-   *
-   * Compares head_ and tail_ atomically; may be slightly stale under
-   * concurrency.
-   *
-   * @return true if no elements are in the buffer, false otherwise.
+   * @brief Check if buffer is empty; may be stale under concurrency
    */
-  bool isEmpty() const noexcept {
-    const size_t head = head_.var.load(std::memory_order_acquire);
+  bool isEmpty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Check if buffer is full; may be stale under concurrency
+   */
+  bool isFull() const noexcept { return size() >= Capacity; }
+
+  /**
+   * @brief Approximate number of claimed-but-not-consumed positions
+   */
+  size_t size() const noexcept {
     const size_t tail = tail_.var.load(std::memory_order_acquire);
-    return head == tail;
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    return (head > tail) ? head - tail : 0;
   }
 
+  static constexpr size_t capacity() noexcept { return Capacity; }
+};
+
+/**
+ * @brief Many producers, one consumer
+ *
+ * Producers claim slots with a CAS; the consumer advances tail_ with a plain
+ * store.
+ */
+template<typename Q_TYPE, size_t Capacity, typename WaitStrategy = ringmaster::HybridWait<>>
+using MPSCRingMaster = SequencedRingMaster<Q_TYPE, Capacity, false, WaitStrategy>;
+
+/**
+ * @brief Many producers, many consumers
+ */
+template<typename Q_TYPE, size_t Capacity, typename WaitStrategy = ringmaster::HybridWait<>>
+using MPMCRingMaster = SequencedRingMaster<Q_TYPE, Capacity, true, WaitStrategy>;
+
+namespace ringmaster::detail {
+
+/**
+ * @struct SeqlockSlot
+ * @brief Slot guarded by a seqlock-style version, for rings that overwrite
+ *
+ * The version of a slot encodes both the position it holds and whether a
+ * write is in progress: a writer of position `pos` stores 2 * pos + 1,
+ * copies the element and then stores 2 * pos + 2. A reader may copy the
+ * element at any time and keeps the copy only if the version was
+ * 2 * pos + 2 both before and after. Readers never write to the slot, so
+ * any number of them can be lapped without slowing the writer down.
+ *
+ * The element is copied byte-wise, so Q_TYPE must be trivially copyable.
+ */
+template<typename Q_TYPE> struct SeqlockSlot {
+  static_assert(std::is_trivially_copyable_v<Q_TYPE>,
+      "Seqlock slots require a trivially copyable Q_TYPE");
+
+  /** Outcome of a read attempt */
+  enum class Read {
+    Ok,     /**< The element for the requested position was copied */
+    Empty,  /**< The position has not been (completely) written yet */
+    Lapped, /**< The slot already holds, or is taking, a later position */
+  };
+
+  std::atomic<size_t> version{0};                      /**< 2 * pos + 2 when pos is readable */
+  alignas(Q_TYPE) unsigned char bytes[sizeof(Q_TYPE)]; /**< Element storage */
+
   /**
-   * @brief Check if buffer is full
-   *
-   * True when advancing head_ would collide with tail_.
-   *
-   * @return true if no additional elements can be pushed, false otherwise.
+   * @brief Store `value` as position `pos`; one writer per slot at a time
    */
-  bool isFull() const noexcept {
-    const size_t head = head_.var.load(std::memory_order_acquire);
-    const size_t tail = tail_.var.load(std::memory_order_acquire);
-    return head - tail >= Capacity;
+  void write(size_t pos, const Q_TYPE &value) noexcept {
+    version.store(2 * pos + 1, std::memory_order_relaxed);
+    // Order the odd version before the payload bytes
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(bytes, &value, sizeof(Q_TYPE));
+    version.store(2 * pos + 2, std::memory_order_release);
   }
 
   /**
-   * @brief Get approximate count of elements in buffer
-   *
-   * Computes difference between head_ and tail_; may be stale under heavy
-   * concurrency.
+   * @brief Copy the bytes of position `pos` to `out` if the slot still holds it
    *
-   * @return Number of elements currently held in buffer
+   * `out` needs no live Q_TYPE: it may be raw storage of sizeof(Q_TYPE)
+   * bytes, so Q_TYPE does not have to be default-constructible. It is left
+   * untouched unless the result is Read::Ok.
    */
-  size_t size() const noexcept {
-    const size_t head = head_.var.load(std::memory_order_acquire);
-    const size_t tail = tail_.var.load(std::memory_order_acquire);
-    return head - tail;
+  Read read(size_t pos, void *out) const noexcept {
+    const size_t want   = 2 * pos + 2;
+    const size_t before = version.load(std::memory_order_acquire);
+    if (before < want) return Read::Empty;
+    if (before > want) return Read::Lapped;
+
+    alignas(Q_TYPE) std::byte copy[sizeof(Q_TYPE)];
+    std::memcpy(copy, bytes, sizeof(Q_TYPE));
+    // Order the payload reads before the version re-check
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (version.load(std::memory_order_relaxed) != want) return Read::Lapped;
+
+    std::memcpy(out, copy, sizeof(Q_TYPE));
+    return Read::Ok;
   }
 
   /**
-   * @brief Push with adaptive spin-then-block waiting
+   * @brief Position a reader lapped at `pos` resumes from
    *
-   * This call will attempt to push the supplied value into the ring. It
-   * first busy-spins for up to `spin_limit` failed attempts to keep
-   * latency low for short waits. If the ring remains full it will then
-   * block on a condition variable until space becomes available.
+   * Skips to one past the oldest element, whose slot the producer writes
+   * next, to stay clear of the write in progress. The writer's `head` may
+   * be stale, since nothing orders it after the version that reported the
+   * lap, so the position this slot was taken by also bounds the producer's
+   * progress. That position is at least `pos + capacity`, which keeps the
+   * result past `pos`.
    *
-   * @tparam ENQ_TYPE Deduced type for the value to insert
-   * @param value Value to insert (forwarded)
-   * @param spin_limit Number of spin attempts before blocking (default 1024)
-   * @param spin_counter Optional pointer to atomic counter to accumulate spin attempts
-   * @param block_counter Optional pointer to atomic counter incremented on each block
+   * @param pos Position whose read returned Read::Lapped
+   * @param head Producer's next position as last loaded by the reader
+   * @param capacity Number of slots in the ring
    */
-  template<typename ENQ_TYPE>
-  void push_wait(ENQ_TYPE &&value,
-      size_t                spin_limit    = 1024,
-      std::atomic<size_t>  *spin_counter  = nullptr,
-      std::atomic<size_t>  *block_counter = nullptr) noexcept {
-    // Local accumulator for spins to avoid frequent atomic updates.
-    size_t local_spins = 0;
+  size_t resume(size_t pos, size_t head, size_t capacity) const noexcept {
+    const size_t taken = (version.load(std::memory_order_relaxed) - 1) / 2;
+    const size_t front = (head > taken) ? head : taken;
+    const size_t first = front - capacity + 1;
+    return (first > pos) ? first : pos + 1;
+  }
+};
 
-    // Try until push succeeds. The fastpath uses the existing non-blocking
-    // push() which is optimized for the SPSC case.
-    while (true) {
-      if (push(std::forward<ENQ_TYPE>(value))) {
-        // Successful push: update statistics and notify the consumer.
-        if (spin_counter && local_spins) {
-          spin_counter->fetch_add(local_spins, std::memory_order_relaxed);
-        }
-        // Notify without holding the mutex to avoid unnecessary contention.
-        not_empty_cv_.notify_one();
-        return;
-      }
+} // namespace ringmaster::detail
 
-      ++local_spins;
-      // Short exponential backoff is not necessary here; yield occasionally
-      // to reduce busyness while still remaining responsive.
-      if (local_spins < spin_limit) {
-        if ((local_spins & 0x3FF) == 0) std::this_thread::yield();
-        continue;
-      }
+/**
+ * @class OverwriteRingMaster
+ * @brief Lossy single-producer/single-consumer ring that overwrites the oldest data
+ *
+ * push() never fails and never waits: when the ring is full it simply
+ * replaces the oldest element. Each slot is a ringmaster::detail::SeqlockSlot,
+ * so the consumer detects from the slot version alone whether the element it
+ * wants was overwritten (it was lapped). In that case it skips ahead to the
+ * oldest element still in the ring and adds the skipped elements to
+ * dropped(). The producer never reads anything the consumer writes, so a
+ * slow consumer cannot back up the producer's hot path.
+ *
+ * Suited to telemetry and latest-value snapshot streams where fresh data
+ * matters more than completeness.
+ *
+ * @note Q_TYPE must be trivially copyable; elements are copied byte-wise.
+ * @note The consumer polls: there is no pop_wait(), since the producer never
+ * pays for wake-ups.
+ *
+ * @tparam Q_TYPE Element type stored in the ring
+ * @tparam Capacity Number of slots; must be a power of two
+ */
+template<typename Q_TYPE, size_t Capacity> class OverwriteRingMaster {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+      "Capacity must be a power of two of at least 2");
+
+  // Mask for wrap-around indexing
+  static constexpr size_t Mask = Capacity - 1;
 
-      // Spinning exceeded threshold: enter blocking wait. We increment the
-      // block counter once per blocking entry to let benchmarks observe
-      // how often threads actually block.
-      if (block_counter) block_counter->fetch_add(1, std::memory_order_relaxed);
+  using Slot = ringmaster::detail::SeqlockSlot<Q_TYPE>;
 
-      std::unique_lock<std::mutex> lock(cv_mutex_);
-      // Wait until not full. The predicate checks the ring state so spurious
-      // wakeups are harmless.
-      not_full_cv_.wait(lock, [this]() { return !isFull(); });
+  ringmaster::PaddedAtomic head_{};    /**< Next position to write; written by the producer */
+  ringmaster::PaddedAtomic tail_{};    /**< Next position to read; written by the consumer */
+  ringmaster::PaddedAtomic dropped_{}; /**< Elements skipped after being lapped */
+  alignas(DESTRUCTIVE_INTERFERENCE_SIZE) Slot slots_[Capacity]; /**< Versioned element storage */
 
-      // After wakeup, loop and attempt push again. Reset local spin counter
-      // to account for spins after wakeup.
-      local_spins = 0;
-    }
+public:
+  OverwriteRingMaster() noexcept = default;
+
+  // Non-copyable, non-movable
+  OverwriteRingMaster(const OverwriteRingMaster &)            = delete;
+  OverwriteRingMaster &operator=(const OverwriteRingMaster &) = delete;
+
+  /**
+   * @brief Publish `value`, overwriting the oldest element if the ring is full
+   */
+  void push(const Q_TYPE &value) noexcept {
+    const size_t head = head_.var.load(std::memory_order_relaxed);
+    slots_[head & Mask].write(head, value);
+    head_.var.store(head + 1, std::memory_order_release);
   }
 
   /**
-   * @brief Pop with adaptive spin-then-block waiting
+   * @brief Pop the oldest element still in the ring
    *
-   * Symmetric to push_wait(): busy-spins for `spin_limit` failed attempts
-   * to pop, then blocks on a condition variable if the ring remains empty.
+   * If the next element was overwritten, skips ahead to the oldest one the
+   * producer has not yet reached again and counts the skipped elements in
+   * dropped().
    *
-   * @param out Reference that receives the popped element
-   * @param spin_limit Number of spin attempts before blocking (default 1024)
-   * @param spin_counter Optional pointer to atomic counter to accumulate spin attempts
-   * @param block_counter Optional pointer to atomic counter incremented on each block
-   * @return true on successful pop (always returns true eventually)
+   * @param out Reference where the popped element is stored
+   * @return true if an element was available, false if the ring was empty
+   */
+  bool pop(Q_TYPE &out) noexcept { return pop_bytes(std::addressof(out)); }
+
+  /**
+   * @brief Pop the oldest element by value
+   *
+   * @return The element, or std::nullopt if the ring was empty
+   */
+  std::optional<Q_TYPE> pop() noexcept {
+    alignas(Q_TYPE) std::byte raw[sizeof(Q_TYPE)];
+    if (!pop_bytes(raw)) return std::nullopt;
+    return std::bit_cast<Q_TYPE>(raw);
+  }
+
+  /**
+   * @brief Total elements the consumer skipped because they were overwritten
+   */
+  size_t dropped() const noexcept { return dropped_.var.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Check if the consumer has caught up; may be stale under concurrency
+   */
+  bool isEmpty() const noexcept { return size() == 0; }
+
+  /**
+   * @brief Approximate number of unread elements, at most Capacity
+   */
+  size_t size() const noexcept {
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    const size_t tail = tail_.var.load(std::memory_order_acquire);
+    const size_t n    = head - tail;
+    return (n > Capacity) ? Capacity : n;
+  }
+
+  static constexpr size_t capacity() noexcept { return Capacity; }
+
+private:
+  /**
+   * @brief Body of both pop() overloads; copies the element's bytes to `out`
    */
-  bool pop_wait(Q_TYPE    &out,
-      size_t               spin_limit    = 1024,
-      std::atomic<size_t> *spin_counter  = nullptr,
-      std::atomic<size_t> *block_counter = nullptr) noexcept {
-    size_t local_spins = 0;
+  bool pop_bytes(void *out) noexcept {
+    size_t tail = tail_.var.load(std::memory_order_relaxed);
 
     while (true) {
-      if (pop(out)) {
-        if (spin_counter && local_spins) {
-          spin_counter->fetch_add(local_spins, std::memory_order_relaxed);
-        }
-        // Wake producer that space is available.
-        not_full_cv_.notify_one();
+      switch (slots_[tail & Mask].read(tail, out)) {
+      case Slot::Read::Ok:
+        tail_.var.store(tail + 1, std::memory_order_release);
         return true;
+      case Slot::Read::Empty:
+        return false;
+      case Slot::Read::Lapped:
+        break;
       }
 
-      ++local_spins;
-      if (local_spins < spin_limit) {
-        if ((local_spins & 0x3FF) == 0) std::this_thread::yield();
-        continue;
-      }
-
-      if (block_counter) block_counter->fetch_add(1, std::memory_order_relaxed);
-      std::unique_lock<std::mutex> lock(cv_mutex_);
-      not_empty_cv_.wait(lock, [this]() { return !isEmpty(); });
-      local_spins = 0;
+      const size_t head = head_.var.load(std::memory_order_acquire);
+      const size_t next = slots_[tail & Mask].resume(tail, head, Capacity);
+      dropped_.var.store(
+          dropped_.var.load(std::memory_order_relaxed) + (next - tail), std::memory_order_relaxed);
+      tail = next;
+      tail_.var.store(tail, std::memory_order_release);
     }
   }
-};
\ No newline at end of file
+};
@@ -0,0 +1,241 @@
+#pragma once
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief C++20 coroutine front-end for RingMaster
+ *
+ * This header defines AsyncRingMaster, which adds `co_await`-able
+ * async_push() and async_pop() to an SPSC ring. An awaiter that finds space
+ * (or data) completes synchronously without suspending. Otherwise it
+ * publishes its coroutine handle in a padded slot and suspends, and the
+ * opposite side hands the handle to a Resumer after its next successful
+ * operation. No OS thread ever blocks, so the ring can sit between
+ * coroutines driven by an event loop (io_uring, epoll, ...) and plain
+ * threads calling push()/pop().
+ *
+ * @section Usage
+ * @code
+ * AsyncRingMaster<Request, 1024> ring;
+ *
+ * Task producer() { for (;;) co_await ring.async_push(co_await readRequest()); }
+ * Task consumer() { for (;;) handle(co_await ring.async_pop()); }
+ * @endcode
+ *
+ * @section Resuming
+ * By default a suspended coroutine is resumed inline, on the thread whose
+ * push or pop made progress. Pass a Resumer that posts the handle to the
+ * right executor instead when the two sides run on different event loops:
+ * @code
+ * struct PostToLoop {
+ *   EventLoop *loop;
+ *   void operator()(std::coroutine_handle<> h) const noexcept { loop->post(h); }
+ * };
+ * AsyncRingMaster<Request, 1024, PostToLoop> ring(PostToLoop{&consumer_loop});
+ * @endcode
+ *
+ * @note At most one producer and one consumer operation may be outstanding
+ * at a time, as for every SPSC ring. A coroutine must not be destroyed while
+ * suspended in an awaiter.
+ */
+
+namespace ringmaster {
+
+/**
+ * @struct InlineResume
+ * @brief Resumer that resumes the coroutine on the calling thread
+ */
+struct InlineResume {
+  void operator()(std::coroutine_handle<> h) const noexcept { h.resume(); }
+};
+
+} // namespace ringmaster
+
+/**
+ * @class AsyncRingMaster
+ * @brief SPSC ring with coroutine awaitables for push and pop
+ *
+ * Suspension uses the same handshake as RingMaster's waiter flags: the
+ * awaiter publishes its handle, issues a fence and re-checks the ring, while
+ * the opposite side updates its index, issues a fence and checks for a
+ * handle. Either the awaiter sees the progress, or the other side sees the
+ * handle. Both then race to take the handle back with an exchange, so it is
+ * resumed exactly once, and the element itself is always transferred in
+ * await_resume().
+ *
+ * Constructor arguments after the Resumer are forwarded to the underlying
+ * RingMaster, so runtime-capacity rings work unchanged.
+ *
+ * @tparam Q_TYPE Element type stored in the ring
+ * @tparam Capacity Ring capacity (or ringmaster::DynamicCapacity)
+ * @tparam Resumer Callable invoked with each coroutine handle to resume
+ * @tparam CacheIndices Forwarded to RingMaster
+ */
+template<typename Q_TYPE,
+    size_t Capacity,
+    typename Resumer  = ringmaster::InlineResume,
+    bool CacheIndices = true>
+class AsyncRingMaster {
+  using Ring = RingMaster<Q_TYPE, Capacity, CacheIndices>;
+
+  /**
+   * @struct PaddedHandle
+   * @brief Address of a suspended coroutine, on its own cache line
+   */
+  struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) PaddedHandle {
+    std::atomic<void *> var{nullptr};
+  };
+
+  Ring                          ring_;              /**< Underlying SPSC ring */
+  PaddedHandle                  consumer_waiting_;  /**< Set by a suspended async_pop() */
+  PaddedHandle                  producer_waiting_;  /**< Set by a suspended async_push() */
+  [[no_unique_address]] Resumer resumer_;           /**< Resumes handed-over coroutines */
+
+  /**
+   * @brief Publish `h` in `slot`, then re-check the ring
+   *
+   * Once `h` is published the other side may resume it, destroying the
+   * awaiter and possibly the coroutine frame, so neither `ready` nor the
+   * caller may touch anything in the awaiter afterwards.
+   *
+   * @return true to stay suspended, false to resume immediately
+   */
+  template<typename READY>
+  static bool suspend(PaddedHandle &slot, std::coroutine_handle<> h, READY &&ready) noexcept {
+    slot.var.store(h.address(), std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!ready()) return true;
+
+    // Progress raced with publication: take the handle back unless the
+    // opposite side already did, in which case it resumes us
+    return slot.var.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+  }
+
+  /**
+   * @brief Resume the coroutine parked in `slot`, if any
+   *
+   * Called after publishing an index update; costs a fence and a load when
+   * nobody is suspended.
+   */
+  void wake(PaddedHandle &slot) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (slot.var.load(std::memory_order_relaxed) == nullptr) return;
+    if (void *h = slot.var.exchange(nullptr, std::memory_order_acq_rel)) {
+      resumer_(std::coroutine_handle<>::from_address(h));
+    }
+  }
+
+public:
+  /**
+   * @class PushAwaiter
+   * @brief Awaitable returned by async_push()
+   */
+  template<typename ENQ_TYPE> class [[nodiscard]] PushAwaiter {
+    AsyncRingMaster &owner_;
+    ENQ_TYPE         value_;
+    bool             done_ = false;
+
+  public:
+    PushAwaiter(AsyncRingMaster &owner, ENQ_TYPE &&value) noexcept
+        : owner_(owner), value_(std::forward<ENQ_TYPE>(value)) {}
+
+    bool await_ready() noexcept { return done_ = owner_.push(std::forward<ENQ_TYPE>(value_)); }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+      // Bound before publication; the awaiter may be gone after it
+      AsyncRingMaster &owner = owner_;
+      return suspend(owner.producer_waiting_, h, [&owner]() { return !owner.ring_.isFull(); });
+    }
+
+    /** The single producer found the ring full; the consumer freed a slot */
+    void await_resume() noexcept {
+      if (!done_) owner_.push(std::forward<ENQ_TYPE>(value_));
+    }
+  };
+
+  /**
+   * @class PopAwaiter
+   * @brief Awaitable returned by async_pop()
+   */
+  class [[nodiscard]] PopAwaiter {
+    AsyncRingMaster      &owner_;
+    std::optional<Q_TYPE> value_;
+
+  public:
+    explicit PopAwaiter(AsyncRingMaster &owner) noexcept : owner_(owner) {}
+
+    bool await_ready() noexcept { return (value_ = owner_.pop()).has_value(); }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+      // Bound before publication; the awaiter may be gone after it
+      AsyncRingMaster &owner = owner_;
+      return suspend(owner.consumer_waiting_, h, [&owner]() { return !owner.ring_.isEmpty(); });
+    }
+
+    /** The single consumer found the ring empty; the producer added an element */
+    Q_TYPE await_resume() noexcept {
+      if (!value_) value_ = owner_.pop();
+      return std::move(*value_);
+    }
+  };
+
+  AsyncRingMaster() = default;
+
+  /**
+   * @param resumer Callable that resumes handed-over coroutines
+   * @param args Forwarded to the RingMaster constructor
+   */
+  template<typename... ARGS>
+  explicit AsyncRingMaster(Resumer resumer, ARGS &&...args)
+      : ring_(std::forward<ARGS>(args)...), resumer_(std::move(resumer)) {}
+
+  /**
+   * @brief Push without suspending; resumes a suspended async_pop()
+   *
+   * @return true if insertion succeeded, false if buffer was full
+   */
+  template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept {
+    if (!ring_.push(std::forward<ENQ_TYPE>(value))) return false;
+    wake(consumer_waiting_);
+    return true;
+  }
+
+  /**
+   * @brief Pop without suspending; resumes a suspended async_push()
+   *
+   * @return The oldest element, or std::nullopt if buffer was empty
+   */
+  std::optional<Q_TYPE> pop() noexcept {
+    std::optional<Q_TYPE> out = ring_.pop();
+    if (out) wake(producer_waiting_);
+    return out;
+  }
+
+  /**
+   * @brief Awaitable push: completes immediately when there is space,
+   * otherwise suspends until the consumer frees a slot
+   *
+   * @param value Element to insert; kept in the awaiter until it is pushed
+   */
+  template<typename ENQ_TYPE> PushAwaiter<ENQ_TYPE> async_push(ENQ_TYPE &&value) noexcept {
+    return PushAwaiter<ENQ_TYPE>(*this, std::forward<ENQ_TYPE>(value));
+  }
+
+  /**
+   * @brief Awaitable pop: completes immediately when an element is ready,
+   * otherwise suspends until the producer pushes one
+   *
+   * @return Awaiter whose `co_await` yields the element
+   */
+  PopAwaiter async_pop() noexcept { return PopAwaiter(*this); }
+
+  bool   isEmpty() const noexcept { return ring_.isEmpty(); }
+  bool   isFull() const noexcept { return ring_.isFull(); }
+  size_t size() const noexcept { return ring_.size(); }
+  size_t capacity() const noexcept { return ring_.capacity(); }
+};
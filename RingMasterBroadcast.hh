@@ -0,0 +1,307 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Single-producer, multi-reader broadcast ring
+ *
+ * This header defines BroadcastRingMaster, a Disruptor-style fan-out ring:
+ * one producer writes every element once, and each of `Readers` readers
+ * walks the same slots with its own padded cursor. Memory and write
+ * bandwidth are O(1) per element regardless of the number of readers, where
+ * fanning out through one RingMaster per reader costs O(N).
+ *
+ * @section Modes
+ * - Gated (default): the producer never overwrites an element some reader
+ * has not consumed yet. It keeps a private copy of the slowest cursor and
+ * only rescans the cursors when that copy says the ring is full, like
+ * RingMaster's CacheIndices mode. Every reader must keep consuming, or the
+ * producer stalls.
+ * - Lossy: the producer never waits. Slots are
+ * ringmaster::detail::SeqlockSlot, as in OverwriteRingMaster; a reader that
+ * was lapped skips ahead and counts the loss in dropped(reader). Q_TYPE must
+ * be trivially copyable.
+ *
+ * @section Usage
+ * @code
+ * BroadcastRingMaster<Tick, 4096, 4> feed;
+ *
+ * // producer
+ * feed.push_wait(tick);
+ *
+ * // reader r (0 <= r < 4), each on its own thread
+ * Tick t;
+ * feed.pop_wait(r, t);
+ * @endcode
+ *
+ * @note One thread may act as reader r at a time. Readers receive copies,
+ * since every reader sees every element.
+ * @note A reader parked in pop_wait() is only woken by push_wait(), and a
+ * producer parked in push_wait() only by pop_wait(); pair the blocking calls.
+ *
+ * @tparam Q_TYPE Element type stored in the ring
+ * @tparam Capacity Number of slots; must be a power of two
+ * @tparam Readers Number of reader cursors
+ * @tparam Lossy Overwrite the oldest elements instead of gating on readers
+ * @tparam WaitStrategy Policy used by push_wait()/pop_wait() between failed
+ * attempts (see ringmaster::HybridWait)
+ */
+template<typename Q_TYPE,
+    size_t Capacity,
+    size_t Readers,
+    bool Lossy            = false,
+    typename WaitStrategy = ringmaster::HybridWait<>>
+class BroadcastRingMaster {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+      "Capacity must be a power of two of at least 2");
+  static_assert(Readers >= 1, "A broadcast ring needs at least one reader");
+
+  // Mask for wrap-around indexing
+  static constexpr size_t Mask = Capacity - 1;
+
+  using SeqlockSlot = ringmaster::detail::SeqlockSlot<Q_TYPE>;
+
+  /**
+   * @struct SeqlockSlots
+   * @brief Versioned slot array used in lossy mode
+   */
+  struct SeqlockSlots {
+    alignas(DESTRUCTIVE_INTERFERENCE_SIZE) SeqlockSlot slots[Capacity];
+  };
+
+  using Storage = std::conditional_t<Lossy,
+      SeqlockSlots,
+      ringmaster::detail::RingStorage<Q_TYPE, Capacity>>;
+
+  /**
+   * @struct ReaderState
+   * @brief Per-reader data only that reader writes
+   */
+  struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) ReaderState {
+    size_t              head_cache = 0; /**< Reader's copy of head_ (gated mode) */
+    std::atomic<size_t> dropped{0};     /**< Elements skipped after being lapped */
+  };
+
+  ringmaster::PaddedAtomic head_{};          /**< Next position to write */
+  ringmaster::PaddedIndex  gate_cache_{};    /**< Producer's copy of the slowest cursor */
+  ringmaster::PaddedAtomic cursors_[Readers]; /**< Next position of each reader */
+  ReaderState              readers_[Readers]; /**< Reader-private state */
+  Storage                  storage_;          /**< Element slots */
+
+  ringmaster::EventCount not_empty_; /**< Readers parked in pop_wait() */
+  ringmaster::EventCount not_full_;  /**< Producer parked in push_wait() */
+
+  /** Smallest reader cursor; the oldest position still needed */
+  size_t slowest() const noexcept {
+    size_t min = cursors_[0].var.load(std::memory_order_acquire);
+    for (size_t r = 1; r < Readers; ++r) {
+      const size_t pos = cursors_[r].var.load(std::memory_order_acquire);
+      if (pos < min) min = pos;
+    }
+    return min;
+  }
+
+public:
+  /**
+   * @brief Start with every reader at position 0
+   */
+  BroadcastRingMaster() noexcept {
+    for (auto &c : cursors_) c.var.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Destroy the elements still held in the slots (gated mode)
+   */
+  ~BroadcastRingMaster() {
+    if constexpr (!Lossy && !std::is_trivially_destructible_v<Q_TYPE>) {
+      const size_t head  = head_.var.load(std::memory_order_relaxed);
+      const size_t first = (head > Capacity) ? head - Capacity : 0;
+      for (size_t pos = first; pos < head; ++pos) std::destroy_at(storage_.data() + (pos & Mask));
+    }
+  }
+
+  // Non-copyable, non-movable
+  BroadcastRingMaster(const BroadcastRingMaster &)            = delete;
+  BroadcastRingMaster &operator=(const BroadcastRingMaster &) = delete;
+
+  /**
+   * @brief Publish an element to all readers
+   *
+   * In gated mode the element is constructed in its slot, replacing the one
+   * every reader has already passed. In lossy mode it is copied into its
+   * seqlock slot, overwriting the oldest element if needed.
+   *
+   * @tparam ENQ_TYPE Type deduced for insertion (Q_TYPE must be
+   * constructible from it)
+   * @param value Element to insert (forwarded)
+   * @return true if insertion succeeded, false if the slowest reader is a full
+   * ring behind (gated mode only)
+   */
+  template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept {
+    const size_t head = head_.var.load(std::memory_order_relaxed);
+
+    if constexpr (Lossy) {
+      storage_.slots[head & Mask].write(head, Q_TYPE(std::forward<ENQ_TYPE>(value)));
+    } else {
+      if (head - gate_cache_.var >= Capacity) {
+        gate_cache_.var = slowest();
+        if (head - gate_cache_.var >= Capacity) return false; // slowest reader is a lap behind
+      }
+      Q_TYPE *slot = storage_.data() + (head & Mask);
+      if constexpr (!std::is_trivially_destructible_v<Q_TYPE>) {
+        if (head >= Capacity) std::destroy_at(slot);
+      }
+      std::construct_at(slot, std::forward<ENQ_TYPE>(value));
+    }
+
+    // Use release ordering so the element is visible before head_ moves
+    head_.var.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Copy the next element for `reader` into `out`
+   *
+   * @param reader Reader index, 0 <= reader < Readers
+   * @param out Reference where the element is stored
+   * @return true if an element was available, false if the reader is
+   * caught up
+   */
+  bool pop(size_t reader, Q_TYPE &out) noexcept {
+    return take(reader, [&out](const Q_TYPE &value) noexcept { out = value; });
+  }
+
+  /**
+   * @brief Pop the next element for `reader` by value
+   *
+   * @return The element, or std::nullopt if the reader is caught up
+   */
+  std::optional<Q_TYPE> pop(size_t reader) noexcept {
+    std::optional<Q_TYPE> out;
+    take(reader, [&out](const Q_TYPE &value) noexcept { out.emplace(value); });
+    return out;
+  }
+
+  /**
+   * @brief Push, waiting according to WaitStrategy while the ring is full
+   *
+   * Never waits in lossy mode. Wakes readers parked in pop_wait().
+   *
+   * @param value Value to insert (forwarded)
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   */
+  template<typename ENQ_TYPE> void push_wait(ENQ_TYPE &&value, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (!push(std::forward<ENQ_TYPE>(value))) {
+      if (waiter.spin()) continue;
+      not_full_.wait_until([this]() { return !isFull(); });
+      waiter = WaitStrategy(spin_limit);
+    }
+    if constexpr (WaitStrategy::parks) not_empty_.notify_all();
+  }
+
+  /**
+   * @brief Pop for `reader`, waiting according to WaitStrategy while caught up
+   *
+   * @param reader Reader index, 0 <= reader < Readers
+   * @param out Reference that receives the element
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true on successful pop (always returns true eventually)
+   */
+  bool pop_wait(size_t reader, Q_TYPE &out, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (!pop(reader, out)) {
+      if (waiter.spin()) continue;
+      not_empty_.wait_until([this, reader]() { return !isEmpty(reader); });
+      waiter = WaitStrategy(spin_limit);
+    }
+    if constexpr (!Lossy && WaitStrategy::parks) not_full_.notify_all();
+    return true;
+  }
+
+  /**
+   * @brief Check if `reader` is caught up; may be stale under concurrency
+   */
+  bool isEmpty(size_t reader) const noexcept { return size(reader) == 0; }
+
+  /**
+   * @brief Check if the slowest reader is a full ring behind (gated mode)
+   */
+  bool isFull() const noexcept {
+    if constexpr (Lossy) return false;
+    return head_.var.load(std::memory_order_acquire) - slowest() >= Capacity;
+  }
+
+  /**
+   * @brief Approximate number of elements `reader` has not read, at most Capacity
+   */
+  size_t size(size_t reader) const noexcept {
+    const size_t pos  = cursors_[reader].var.load(std::memory_order_acquire);
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    const size_t n    = (head > pos) ? head - pos : 0;
+    return (n > Capacity) ? Capacity : n;
+  }
+
+  /**
+   * @brief Elements `reader` skipped because they were overwritten (lossy mode)
+   */
+  size_t dropped(size_t reader) const noexcept {
+    return readers_[reader].dropped.load(std::memory_order_relaxed);
+  }
+
+  static constexpr size_t capacity() noexcept { return Capacity; }
+  static constexpr size_t readers() noexcept { return Readers; }
+
+private:
+  /**
+   * @brief Hand the next element for `reader` to `sink`, then release it
+   *
+   * Shared body of both pop() overloads. Neither needs a default-constructed
+   * Q_TYPE: seqlock slots are copied into raw bytes first.
+   */
+  template<typename SINK> bool take(size_t reader, SINK &&sink) noexcept {
+    ringmaster::PaddedAtomic &cursor = cursors_[reader];
+    ReaderState              &state  = readers_[reader];
+    size_t                    pos    = cursor.var.load(std::memory_order_relaxed);
+
+    if constexpr (Lossy) {
+      alignas(Q_TYPE) std::byte raw[sizeof(Q_TYPE)];
+      while (true) {
+        switch (storage_.slots[pos & Mask].read(pos, raw)) {
+        case SeqlockSlot::Read::Ok:
+          cursor.var.store(pos + 1, std::memory_order_release);
+          sink(std::bit_cast<Q_TYPE>(raw));
+          return true;
+        case SeqlockSlot::Read::Empty:
+          return false;
+        case SeqlockSlot::Read::Lapped:
+          break;
+        }
+        const size_t head = head_.var.load(std::memory_order_acquire);
+        const size_t next = storage_.slots[pos & Mask].resume(pos, head, Capacity);
+        const size_t lost  = state.dropped.load(std::memory_order_relaxed) + (next - pos);
+        state.dropped.store(lost, std::memory_order_relaxed);
+        pos = next;
+        cursor.var.store(pos, std::memory_order_release);
+      }
+    } else {
+      if (state.head_cache == pos) {
+        state.head_cache = head_.var.load(std::memory_order_acquire);
+        if (state.head_cache == pos) return false; // caught up
+      }
+      sink(static_cast<const Q_TYPE &>(storage_.data()[pos & Mask]));
+
+      // Use release ordering so the copy completes before the slot can be reused
+      cursor.var.store(pos + 1, std::memory_order_release);
+      return true;
+    }
+  }
+};
@@ -0,0 +1,221 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Variable-length record ring for SPSC message passing
+ *
+ * This header defines ByteRingMaster, a byte-oriented sibling of RingMaster
+ * that stores length-prefixed records back to back in one contiguous byte
+ * array. Small messages are packed densely instead of occupying a slot sized
+ * for the largest message, and large ones are still written and read in
+ * place through try_claim()/commit() and peek()/release().
+ *
+ * @section Format
+ * Every record starts with an 8-byte RecordHeader holding the payload
+ * length, and is padded so the next header is 8-byte aligned. A record never
+ * wraps: if it does not fit before the end of the array, the producer writes
+ * a wrap marker (a header whose length is WRAP_MARKER) and places the record
+ * at offset 0. The consumer skips wrap markers transparently.
+ *
+ * @section Usage
+ * @code
+ * ByteRingMaster<1 << 20> ring;
+ *
+ * // producer
+ * auto buf = ring.try_claim(msg_len);
+ * if (buf.data()) {
+ *   serialize(msg, buf);
+ *   ring.commit(msg_len);
+ * }
+ *
+ * // consumer
+ * auto rec = ring.peek();
+ * if (rec.data()) {
+ *   handle(rec);
+ *   ring.release();
+ * }
+ * @endcode
+ *
+ * @tparam Capacity Size of the byte array; a power of two of at least 64
+ */
+template<size_t Capacity> class ByteRingMaster {
+  static_assert(Capacity >= 64 && (Capacity & (Capacity - 1)) == 0,
+      "Capacity must be a power of two of at least 64 bytes");
+
+  // Mask for wrap-around indexing
+  static constexpr size_t Mask = Capacity - 1;
+
+  /**
+   * @struct RecordHeader
+   * @brief Length prefix written in front of every record
+   */
+  struct RecordHeader {
+    uint32_t length;   /**< Payload bytes, or WRAP_MARKER */
+    uint32_t reserved; /**< Keeps payloads 8-byte aligned */
+  };
+
+  static constexpr uint32_t WRAP_MARKER  = 0xFFFFFFFFu;
+  static constexpr size_t   RECORD_ALIGN = sizeof(RecordHeader);
+
+  /** Bytes a record with `size` payload bytes occupies, header included */
+  static constexpr size_t footprint(size_t size) noexcept {
+    return (sizeof(RecordHeader) + size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1);
+  }
+
+  ringmaster::PaddedAtomic head_{};       /**< Producer byte offset (end of published data) */
+  ringmaster::PaddedAtomic tail_{};       /**< Consumer byte offset (start of unread data) */
+  ringmaster::PaddedIndex  tail_cache_{}; /**< Producer's copy of tail_ */
+  ringmaster::PaddedIndex  claim_pad_{};  /**< Wrap padding chosen by the last try_claim() */
+  ringmaster::PaddedIndex  head_cache_{}; /**< Consumer's copy of head_ */
+  ringmaster::PaddedIndex  release_to_{}; /**< tail_ value to publish on release() */
+  alignas(CACHE_LINE_SIZE) std::byte buffer_[Capacity]; /**< Record storage, cache-line aligned */
+
+public:
+  /** Largest payload a single record may carry */
+  static constexpr size_t MaxRecord = Capacity / 2 - sizeof(RecordHeader);
+
+  ByteRingMaster() noexcept = default;
+
+  // Non-copyable, non-movable
+  ByteRingMaster(const ByteRingMaster &)            = delete;
+  ByteRingMaster &operator=(const ByteRingMaster &) = delete;
+
+  /**
+   * @brief Reserve contiguous space for a record of `size` payload bytes
+   *
+   * The returned span points straight into the ring. Nothing is visible to
+   * the consumer until commit(). Calling try_claim() again before commit()
+   * replaces the previous reservation.
+   *
+   * @param size Payload bytes wanted; at most MaxRecord
+   * @return Writable payload, or an empty span with data() == nullptr if the
+   * ring lacks space or size exceeds MaxRecord
+   */
+  std::span<std::byte> try_claim(size_t size) noexcept {
+    if (size > MaxRecord) return {};
+
+    const size_t head  = head_.var.load(std::memory_order_relaxed);
+    const size_t idx   = head & Mask;
+    const size_t need  = footprint(size);
+    const size_t pad   = (idx + need > Capacity) ? Capacity - idx : 0;
+    const size_t total = pad + need;
+
+    if (Capacity - (head - tail_cache_.var) < total) {
+      tail_cache_.var = tail_.var.load(std::memory_order_acquire);
+      if (Capacity - (head - tail_cache_.var) < total) return {}; // buffer full
+    }
+
+    claim_pad_.var = pad;
+    const size_t at = (idx + pad) & Mask;
+    return {buffer_ + at + sizeof(RecordHeader), size};
+  }
+
+  /**
+   * @brief Publish the record reserved by the last try_claim()
+   *
+   * @param size Payload bytes actually written; must not exceed the claimed size
+   */
+  void commit(size_t size) noexcept {
+    const size_t head = head_.var.load(std::memory_order_relaxed);
+    const size_t pad  = claim_pad_.var;
+
+    if (pad) {
+      const RecordHeader wrap{WRAP_MARKER, 0};
+      std::memcpy(buffer_ + (head & Mask), &wrap, sizeof(wrap));
+    }
+    const RecordHeader hdr{static_cast<uint32_t>(size), 0};
+    std::memcpy(buffer_ + ((head + pad) & Mask), &hdr, sizeof(hdr));
+
+    // Use release ordering so the payload and headers are visible before head_
+    head_.var.store(head + pad + footprint(size), std::memory_order_release);
+  }
+
+  /**
+   * @brief Copy a complete record into the ring
+   *
+   * @param data Payload to store
+   * @return true if the record was published, false if there was no space
+   */
+  bool push(std::span<const std::byte> data) noexcept {
+    std::span<std::byte> dst = try_claim(data.size());
+    if (!dst.data()) return false;
+    if (!data.empty()) std::memcpy(dst.data(), data.data(), data.size());
+    commit(data.size());
+    return true;
+  }
+
+  /**
+   * @brief Access the oldest record in place
+   *
+   * The record stays owned by the consumer until release().
+   *
+   * @return Payload of the oldest record, or an empty span with
+   * data() == nullptr if the ring is empty
+   */
+  std::span<const std::byte> peek() noexcept {
+    size_t tail = tail_.var.load(std::memory_order_relaxed);
+
+    while (true) {
+      if (head_cache_.var == tail) {
+        head_cache_.var = head_.var.load(std::memory_order_acquire);
+        if (head_cache_.var == tail) return {}; // buffer empty
+      }
+
+      RecordHeader hdr;
+      std::memcpy(&hdr, buffer_ + (tail & Mask), sizeof(hdr));
+      if (hdr.length != WRAP_MARKER) {
+        release_to_.var = tail + footprint(hdr.length);
+        return {buffer_ + (tail & Mask) + sizeof(RecordHeader), hdr.length};
+      }
+      // Skip the padding up to the end of the array; the record starts at 0
+      tail += Capacity - (tail & Mask);
+    }
+  }
+
+  /**
+   * @brief Hand the record returned by the last peek() back to the producer
+   */
+  void release() noexcept {
+    // Use release ordering so in-place reads complete before tail_ moves
+    tail_.var.store(release_to_.var, std::memory_order_release);
+  }
+
+  /**
+   * @brief Invoke `visitor` on the oldest record, then release it
+   *
+   * @tparam F Callable accepting std::span<const std::byte>
+   * @param visitor Called with the record payload
+   * @return true if a record was consumed, false if the ring was empty
+   */
+  template<typename F> bool pop(F &&visitor) {
+    std::span<const std::byte> rec = peek();
+    if (!rec.data()) return false;
+    visitor(rec);
+    release();
+    return true;
+  }
+
+  /**
+   * @brief Check if the ring holds no records; may be stale under concurrency
+   */
+  bool isEmpty() const noexcept {
+    return head_.var.load(std::memory_order_acquire) == tail_.var.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Bytes in use, including headers and padding; may be stale
+   */
+  size_t bytesUsed() const noexcept {
+    const size_t head = head_.var.load(std::memory_order_acquire);
+    const size_t tail = tail_.var.load(std::memory_order_acquire);
+    return head - tail;
+  }
+
+  static constexpr size_t capacity() noexcept { return Capacity; }
+};
@@ -0,0 +1,173 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Parallel processing of one ring's elements with in-order retirement
+ *
+ * This header defines ringmaster::CompletionWindow, which lets the consumer
+ * of an SPSC ring act as a dispatcher for a small worker pool. The
+ * dispatcher claims consecutive ranges of published elements by sequence
+ * number (see RingMaster::peek_from()) and hands them to workers, which
+ * process the elements in place and report completion in any order. The
+ * dispatcher then retires the longest completed prefix with a single tail_
+ * store, so the producer only ever sees slots freed in order.
+ *
+ * @section Usage
+ * @code
+ * RingMaster<Order, 4096> ring;
+ * ringmaster::CompletionWindow<RingMaster<Order, 4096>> window(ring);
+ *
+ * // dispatcher (the ring's consumer thread)
+ * for (;;) {
+ *   if (auto batch = window.claim(64); batch.size()) pool.post(batch);
+ *   window.retire();
+ * }
+ *
+ * // any worker
+ * for (size_t i = 0; i < batch.size(); ++i) handle(batch.elements[i]);
+ * window.complete(batch.seq, batch.size());
+ * @endcode
+ *
+ * @note claim() and retire() belong to the consumer side and must be called
+ * from one thread. complete() may be called from any thread.
+ * @note The window counts sequences in size_t, starting from the ring's
+ * sequence(). With a 32-bit ring index (ringmaster::CompactLayout) the
+ * ring's positions wrap at 2^32 while the window's keep counting. This
+ * works only because RingMaster::peek_from() and acknowledge() take
+ * sequence differences modulo the index width, and because Window divides
+ * 2^32, so a batch's completion bits do not depend on the high bits.
+ */
+
+namespace ringmaster {
+
+/**
+ * @class CompletionWindow
+ * @brief Out-of-order completion bitmap over the unretired part of a ring
+ *
+ * Bit `seq % Window` is set when the element with sequence `seq` has been
+ * processed. At most Window elements are claimed but unretired at a time,
+ * so a bit is never reused before retire() has consumed and cleared it.
+ * Workers set bits with a release fetch_or, and retire() reads them with
+ * acquire, so a worker's in-place writes happen before the slot is handed
+ * back to the producer.
+ *
+ * @tparam RING RingMaster specialization with a contiguous Layout
+ * @tparam Window Maximum number of claimed, unretired elements; a power of
+ * two, at least 64
+ */
+template<typename RING, size_t Window = 1024> class CompletionWindow {
+  static_assert(Window >= 64 && (Window & (Window - 1)) == 0,
+      "Window must be a power of two of at least 64");
+
+  // Number of 64-bit completion words
+  static constexpr size_t Words = Window / 64;
+
+  alignas(DESTRUCTIVE_INTERFERENCE_SIZE) std::atomic<uint64_t> done_[Words]; /**< Completion bits */
+
+  RING  &ring_;  /**< Ring whose consumer side this window drives */
+  size_t acked_; /**< Sequences below this are retired; may run past the ring's index width */
+  size_t next_;  /**< Sequence returned by the next claim() */
+
+public:
+  using Segments = typename RING::Segments;
+
+  /**
+   * @struct Batch
+   * @brief Consecutive elements handed out by claim()
+   */
+  struct Batch {
+    size_t   seq = 0;  /**< Sequence number of elements[0] */
+    Segments elements; /**< The elements, in place in the ring */
+
+    size_t size() const noexcept { return elements.size(); }
+  };
+
+  /**
+   * @param ring Ring to consume from; nothing else may consume from it
+   * while the window is in use
+   */
+  explicit CompletionWindow(RING &ring) noexcept
+      : ring_(ring), acked_(ring.sequence()), next_(acked_) {
+    for (auto &word : done_) word.store(0, std::memory_order_relaxed);
+  }
+
+  // Non-copyable, non-movable
+  CompletionWindow(const CompletionWindow &)            = delete;
+  CompletionWindow &operator=(const CompletionWindow &) = delete;
+
+  /**
+   * @brief Take up to `max` published elements that were not claimed yet
+   *
+   * @return The elements, or an empty batch if nothing new is published or
+   * Window elements are already in flight
+   */
+  Batch claim(size_t max) noexcept {
+    const size_t room = Window - (next_ - acked_);
+    Batch        batch{next_, ring_.peek_from(next_, (max > room) ? room : max)};
+    next_ += batch.size();
+    return batch;
+  }
+
+  /**
+   * @brief Mark `count` elements starting at sequence `seq` as processed
+   *
+   * Safe from any thread; elements may complete in any order.
+   */
+  void complete(size_t seq, size_t count) noexcept {
+    while (count) {
+      const size_t   bit  = seq & (Window - 1);
+      const size_t   off  = bit % 64;
+      const size_t   run  = (count < 64 - off) ? count : 64 - off;
+      const uint64_t mask = (run == 64) ? ~uint64_t(0) : ((uint64_t(1) << run) - 1) << off;
+      done_[bit / 64].fetch_or(mask, std::memory_order_release);
+      seq += run;
+      count -= run;
+    }
+  }
+
+  /**
+   * @brief Retire the completed elements at the front of the window
+   *
+   * Clears the completion bits of the longest fully processed prefix and
+   * acknowledges it on the ring with a single tail_ store.
+   *
+   * @return Number of elements retired
+   */
+  size_t retire() noexcept {
+    size_t seq = acked_;
+    while (seq != next_) {
+      const size_t   bit  = seq & (Window - 1);
+      const size_t   off  = bit % 64;
+      const uint64_t bits = done_[bit / 64].load(std::memory_order_acquire) >> off;
+      size_t         run  = std::countr_one(bits);
+      if (run > next_ - seq) run = next_ - seq;
+      if (run == 0) break;
+
+      const uint64_t mask = (run == 64) ? ~uint64_t(0) : ((uint64_t(1) << run) - 1) << off;
+      done_[bit / 64].fetch_and(~mask, std::memory_order_relaxed);
+      seq += run;
+      if (off + run < 64) break; // stopped at an element still in progress
+    }
+
+    const size_t retired = seq - acked_;
+    if (retired) {
+      acked_ = seq;
+      ring_.acknowledge(seq);
+    }
+    return retired;
+  }
+
+  /**
+   * @brief Number of claimed elements not retired yet
+   */
+  size_t inFlight() const noexcept { return next_ - acked_; }
+
+  static constexpr size_t window() noexcept { return Window; }
+};
+
+} // namespace ringmaster
@@ -0,0 +1,201 @@
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief RingMaster consumer notifications through an eventfd
+ *
+ * This header defines EventFdRingMaster, an SPSC ring whose consumer can be
+ * multiplexed with sockets in an epoll or io_uring event loop. The consumer
+ * registers fd() for readability. The producer writes to the eventfd only
+ * when it publishes into a ring the consumer has declared empty (the
+ * empty-to-non-empty transition), so a busy stream costs one syscall per
+ * drain cycle instead of one per element.
+ *
+ * @section Usage
+ * @code
+ * EventFdRingMaster<Order, 4096> ring;
+ * epoll_event ev{EPOLLIN, {.ptr = &ring}};
+ * epoll_ctl(ep, EPOLL_CTL_ADD, ring.fd(), &ev);
+ *
+ * // producer thread
+ * ring.push(order);
+ *
+ * // event loop, whenever ring.fd() is readable
+ * ring.poll([](Order &o) noexcept { handle(o); });
+ * @endcode
+ *
+ * @note Linux only. The consumer must only touch the ring through poll() or
+ * pop() followed by arm(); otherwise the notification is not re-armed.
+ */
+
+/**
+ * @class EventFdRingMaster
+ * @brief SPSC ring that signals an eventfd on the empty-to-non-empty transition
+ *
+ * The consumer raises `armed_` once it has drained the ring, then re-checks
+ * the ring after a fence; the producer issues a fence after every publish
+ * and only writes the eventfd when it can take the armed flag with an
+ * exchange. This is RingMaster's waiter flag handshake with the futex
+ * replaced by a file descriptor, so no element can be published without
+ * either the consumer seeing it or the eventfd becoming readable.
+ *
+ * Constructor arguments are forwarded to the underlying RingMaster, so
+ * runtime-capacity rings work unchanged.
+ *
+ * @tparam Q_TYPE Element type stored in the ring
+ * @tparam Capacity Ring capacity (or ringmaster::DynamicCapacity)
+ * @tparam CacheIndices Forwarded to RingMaster
+ */
+template<typename Q_TYPE, size_t Capacity, bool CacheIndices = true>
+class EventFdRingMaster {
+  using Ring = RingMaster<Q_TYPE, Capacity, CacheIndices, ringmaster::BusySpinWait>;
+
+  Ring                   ring_;         /**< Underlying SPSC ring */
+  ringmaster::PaddedFlag armed_{1, {}}; /**< Raised while the consumer waits on the eventfd */
+  int                    fd_ = -1;      /**< Non-blocking eventfd */
+
+  /**
+   * @brief Write the eventfd if the consumer is armed
+   *
+   * Called after publishing; costs a fence and a load while the consumer is
+   * busy draining.
+   */
+  void notify() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (armed_.var.load(std::memory_order_relaxed) &&
+        armed_.var.exchange(0, std::memory_order_relaxed)) {
+      signal();
+    }
+  }
+
+  /** Make fd() readable; EAGAIN means it already is */
+  void signal() noexcept {
+    const uint64_t one = 1;
+    while (::write(fd_, &one, sizeof(one)) < 0 && errno == EINTR) {}
+  }
+
+public:
+  /**
+   * @param args Forwarded to the RingMaster constructor
+   * @throws std::system_error if the eventfd cannot be created
+   */
+  template<typename... ARGS>
+  explicit EventFdRingMaster(ARGS &&...args) : ring_(std::forward<ARGS>(args)...) {
+    fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "eventfd");
+  }
+
+  ~EventFdRingMaster() { ::close(fd_); }
+
+  // Non-copyable, non-movable
+  EventFdRingMaster(const EventFdRingMaster &)            = delete;
+  EventFdRingMaster &operator=(const EventFdRingMaster &) = delete;
+
+  /**
+   * @brief Descriptor that becomes readable when the ring needs draining
+   */
+  int fd() const noexcept { return fd_; }
+
+  /**
+   * @brief Push an element, signalling the eventfd if the consumer is armed
+   *
+   * @return true if insertion succeeded, false if buffer was full
+   */
+  template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept {
+    if (!ring_.push(std::forward<ENQ_TYPE>(value))) return false;
+    notify();
+    return true;
+  }
+
+  /**
+   * @brief Push up to `count` elements with at most one signal
+   *
+   * @return Number of elements actually pushed (0 if the buffer was full)
+   */
+  template<typename IT> size_t push_n(IT first, size_t count) noexcept {
+    const size_t n = ring_.push_n(first, count);
+    if (n) notify();
+    return n;
+  }
+
+  /**
+   * @brief Drain up to `max` elements in place, then re-arm the notification
+   *
+   * Clears the eventfd, visits elements until the ring is empty and the
+   * armed re-check confirms it, or until `max` elements were visited. When
+   * the budget runs out with elements left, the eventfd is signalled again
+   * so a level-triggered event loop comes back to the ring after serving
+   * its other descriptors.
+   *
+   * @tparam F Callable accepting Q_TYPE &; must not throw
+   * @param visitor Called once per element
+   * @param max Maximum number of elements to visit in this call
+   * @return Number of elements visited
+   */
+  template<typename F> size_t poll(F &&visitor, size_t max = Ring::DefaultBatch) noexcept {
+    acknowledge();
+    size_t total = 0;
+    do {
+      total += ring_.consume_all(visitor, max - total);
+      if (arm()) return total;
+    } while (total < max);
+
+    // Budget spent with elements left: stay readable without being armed
+    signal();
+    return total;
+  }
+
+  /**
+   * @brief Pop the oldest element without touching the notification state
+   *
+   * @return true if an element was available, false if buffer was empty
+   */
+  bool pop(Q_TYPE &out) noexcept { return ring_.pop(out); }
+
+  /**
+   * @brief Pop the oldest element by value
+   *
+   * @return The element, or std::nullopt if buffer was empty
+   */
+  std::optional<Q_TYPE> pop() noexcept { return ring_.pop(); }
+
+  /**
+   * @brief Declare the ring drained before waiting on fd()
+   *
+   * @return true if the consumer may now wait for fd() to become readable,
+   * false if an element arrived meanwhile and should be popped first
+   */
+  bool arm() noexcept {
+    armed_.var.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ring_.isEmpty()) return true;
+
+    // Take the flag back unless the producer already did (and signalled)
+    armed_.var.store(0, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * @brief Reset fd() to not readable after it fired
+   */
+  void acknowledge() noexcept {
+    uint64_t value;
+    while (::read(fd_, &value, sizeof(value)) < 0 && errno == EINTR) {}
+  }
+
+  bool   isEmpty() const noexcept { return ring_.isEmpty(); }
+  bool   isFull() const noexcept { return ring_.isFull(); }
+  size_t size() const noexcept { return ring_.size(); }
+  size_t capacity() const noexcept { return ring_.capacity(); }
+};
@@ -0,0 +1,412 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Opt-in push-to-pop latency and occupancy instrumentation
+ *
+ * This header defines InstrumentedRingMaster, a drop-in wrapper around
+ * RingMaster that timestamps every element at push and records the
+ * pop-side latency into a lock-free, HDR-style LatencyHistogram owned by the
+ * consumer. A monitoring thread can read percentiles at any time without
+ * stopping either side. The wrapper also tracks an occupancy high-water mark.
+ *
+ * @section Usage
+ * @code
+ * InstrumentedRingMaster<Order, 4096, ringmaster::TscClock> ring;
+ * // ... producer/consumer use push()/pop() as usual ...
+ * auto snap = ring.latency().snapshot();
+ * double p999 = ring.toNanos(snap.percentile(0.999));
+ * @endcode
+ */
+
+namespace ringmaster {
+
+/**
+ * @struct SteadyClock
+ * @brief Timestamp source based on std::chrono::steady_clock (nanoseconds)
+ */
+struct SteadyClock {
+  static uint64_t now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static double nanosPerTick() noexcept { return 1.0; }
+};
+
+/**
+ * @struct TscClock
+ * @brief Timestamp source reading the CPU time-stamp counter
+ *
+ * Much cheaper than steady_clock on x86, but only comparable across cores
+ * on CPUs with an invariant, synchronized TSC. The tick rate is calibrated
+ * once against steady_clock on first use. Non-x86 targets fall back to
+ * SteadyClock.
+ */
+struct TscClock {
+  static uint64_t now() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return SteadyClock::now();
+#endif
+  }
+
+  static double nanosPerTick() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double ratio = [] {
+      const uint64_t ns0 = SteadyClock::now();
+      const uint64_t t0  = now();
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      const uint64_t ns1 = SteadyClock::now();
+      const uint64_t t1  = now();
+      return (t1 > t0) ? static_cast<double>(ns1 - ns0) / static_cast<double>(t1 - t0) : 1.0;
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+  }
+};
+
+/**
+ * @class LatencyHistogram
+ * @brief Log-linear (HDR-style) histogram with one writer and any readers
+ *
+ * Values are bucketed with 2^SubBits linear sub-buckets per power of two,
+ * giving a relative error below 2^-SubBits across the whole 64-bit range.
+ * record() is called by a single thread and uses plain relaxed load/store
+ * pairs instead of read-modify-write operations, so recording costs a few
+ * cycles and never contends. Any thread may take a snapshot().
+ *
+ * @tparam SubBits log2 of the sub-buckets per power of two (precision)
+ */
+template<unsigned SubBits = 5> class LatencyHistogram {
+  static_assert(SubBits >= 1 && SubBits <= 10, "SubBits must be between 1 and 10");
+
+public:
+  static constexpr size_t SUB     = size_t(1) << SubBits;     /**< Sub-buckets per octave */
+  static constexpr size_t BUCKETS = (64 - SubBits + 1) * SUB; /**< Buckets covering 64 bits */
+
+  /** Bucket index holding `value` */
+  static constexpr size_t bucketOf(uint64_t value) noexcept {
+    const int    width = std::bit_width(value);
+    const size_t shift = width > int(SubBits + 1) ? size_t(width - SubBits - 1) : 0;
+    return shift * SUB + static_cast<size_t>(value >> shift);
+  }
+
+  /** Smallest value mapped to bucket `idx` */
+  static constexpr uint64_t lowestOf(size_t idx) noexcept {
+    if (idx < 2 * SUB) return idx;
+    const size_t shift = idx / SUB - 1;
+    return static_cast<uint64_t>(idx - shift * SUB) << shift;
+  }
+
+  /** Largest value mapped to bucket `idx` */
+  static constexpr uint64_t highestOf(size_t idx) noexcept {
+    if (idx < 2 * SUB) return idx;
+    const size_t shift = idx / SUB - 1;
+    return lowestOf(idx) + ((uint64_t(1) << shift) - 1);
+  }
+
+  /**
+   * @class Snapshot
+   * @brief Point-in-time copy of the counts, safe to query at leisure
+   *
+   * Subtracting an older snapshot from a newer one yields the distribution
+   * of the values recorded in between.
+   */
+  class Snapshot {
+    std::array<uint64_t, BUCKETS> counts_{};
+    uint64_t                      total_ = 0;
+    uint64_t                      max_   = 0;
+
+    friend class LatencyHistogram;
+
+  public:
+    uint64_t count() const noexcept { return total_; }
+    uint64_t max() const noexcept { return max_; }
+
+    /**
+     * @brief Value at quantile `q` (0..1), reported as its bucket's upper bound
+     */
+    uint64_t percentile(double q) const noexcept {
+      if (total_ == 0) return 0;
+      const uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total_ - 1)) + 1;
+      uint64_t       seen = 0;
+      for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += counts_[i];
+        if (seen >= rank) {
+          const uint64_t hi = highestOf(i);
+          return (hi < max_) ? hi : max_;
+        }
+      }
+      return max_;
+    }
+
+    /** Mean of the recorded values (bucket midpoints) */
+    double mean() const noexcept {
+      if (total_ == 0) return 0.0;
+      double sum = 0.0;
+      for (size_t i = 0; i < BUCKETS; ++i) {
+        if (counts_[i]) sum += counts_[i] * 0.5 * double(lowestOf(i) + highestOf(i));
+      }
+      return sum / static_cast<double>(total_);
+    }
+
+    Snapshot operator-(const Snapshot &older) const noexcept {
+      Snapshot d;
+      for (size_t i = 0; i < BUCKETS; ++i) {
+        d.counts_[i] = counts_[i] - older.counts_[i];
+        d.total_ += d.counts_[i];
+        if (d.counts_[i]) d.max_ = highestOf(i);
+      }
+      if (d.max_ > max_) d.max_ = max_;
+      return d;
+    }
+  };
+
+  /**
+   * @brief Add one value; only one thread may call this
+   */
+  void record(uint64_t value) noexcept {
+    std::atomic<uint64_t> &slot = counts_[bucketOf(value)];
+    slot.store(slot.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (value > max_.load(std::memory_order_relaxed)) max_.store(value, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy the current counts; callable from any thread
+   */
+  Snapshot snapshot() const noexcept {
+    Snapshot s;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+      s.counts_[i] = counts_[i].load(std::memory_order_relaxed);
+      s.total_ += s.counts_[i];
+    }
+    s.max_ = max_.load(std::memory_order_relaxed);
+    return s;
+  }
+
+private:
+  alignas(CACHE_LINE_SIZE) std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+  std::atomic<uint64_t> max_{0}; /**< Largest value recorded */
+};
+
+} // namespace ringmaster
+
+/**
+ * @class InstrumentedRingMaster
+ * @brief RingMaster wrapper measuring push-to-pop latency and occupancy
+ *
+ * Every element is stored next to a Clock timestamp taken when it is placed
+ * in its slot, so time push_wait() spends blocked on a full ring is not
+ * counted. pop() records `now - stamp` in the consumer's LatencyHistogram (in
+ * Clock ticks; toNanos() converts). The producer samples the ring's occupancy every
+ * OCCUPANCY_SAMPLE pushes, and on every push that finds the ring full, and
+ * keeps the maximum as a high-water mark. Sampling keeps it from reading the
+ * consumer's index on every push.
+ *
+ * The template parameters after Clock (CacheIndices, WaitStrategy, Stats
+ * and Layout) are forwarded to the underlying RingMaster; constructor
+ * arguments are forwarded too, so runtime-capacity rings work unchanged.
+ *
+ * @tparam Q_TYPE Element type stored in the ring
+ * @tparam Capacity Ring capacity (or ringmaster::DynamicCapacity)
+ * @tparam Clock Timestamp source (ringmaster::SteadyClock or ringmaster::TscClock)
+ */
+template<typename Q_TYPE,
+    size_t Capacity,
+    typename Clock        = ringmaster::SteadyClock,
+    bool CacheIndices     = true,
+    typename WaitStrategy = ringmaster::HybridWait<>,
+    typename Stats        = ringmaster::NullStats,
+    typename Layout       = ringmaster::DenseLayout<>>
+class InstrumentedRingMaster {
+  /**
+   * @struct Stamped
+   * @brief Element plus the producer-side timestamp
+   */
+  struct Stamped {
+    uint64_t stamp; /**< Clock::now() when placed in its slot */
+    Q_TYPE   value; /**< User element */
+  };
+
+  /**
+   * @struct Restamp
+   * @brief Converts to `s` with a fresh timestamp when the ring constructs
+   * it in a claimed slot
+   */
+  struct Restamp {
+    Stamped &s;
+    operator Stamped() const noexcept { return Stamped{Clock::now(), std::move(s.value)}; }
+  };
+
+  /**
+   * @struct Build
+   * @brief Converts to a freshly stamped element built from `v` when the ring
+   * constructs it in a claimed slot; a full ring never converts it
+   */
+  template<typename ENQ_TYPE> struct Build {
+    ENQ_TYPE &&v;
+    operator Stamped() const noexcept {
+      return Stamped{Clock::now(), Q_TYPE(std::forward<ENQ_TYPE>(v))};
+    }
+  };
+
+  template<typename ENQ_TYPE>
+  static constexpr bool NothrowBuild = std::is_nothrow_constructible_v<Q_TYPE, ENQ_TYPE>;
+
+  static constexpr size_t OCCUPANCY_SAMPLE = 64;
+
+  using Ring = RingMaster<Stamped, Capacity, CacheIndices, WaitStrategy, Stats, Layout>;
+
+  Ring                           ring_;          /**< Underlying SPSC ring */
+  ringmaster::LatencyHistogram<> latency_;       /**< Written by the consumer only */
+  ringmaster::PaddedAtomic       high_water_{};  /**< Written by the producer only */
+  ringmaster::PaddedIndex        pushes_{};      /**< Producer-private push counter */
+
+public:
+  using Histogram = ringmaster::LatencyHistogram<>;
+
+  template<typename... ARGS>
+  explicit InstrumentedRingMaster(ARGS &&...args) : ring_(std::forward<ARGS>(args)...) {}
+
+  /**
+   * @brief Timestamp and push an element if space is available
+   *
+   * When building the element cannot throw it is built in its slot once
+   * the ring has found room, so a failed push leaves `value` untouched.
+   * Otherwise it is built first and moved in; an exception from building it
+   * propagates with the ring unchanged, and a failed push of an lvalue still
+   * leaves it untouched.
+   *
+   * @return true if insertion succeeded, false if buffer was full
+   */
+  template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept(NothrowBuild<ENQ_TYPE>) {
+    bool pushed;
+    if constexpr (NothrowBuild<ENQ_TYPE>) {
+      pushed = ring_.push(Build<ENQ_TYPE>{std::forward<ENQ_TYPE>(value)});
+    } else {
+      Stamped s{0, Q_TYPE(std::forward<ENQ_TYPE>(value))};
+      pushed = ring_.push(Restamp{s});
+    }
+    if (!pushed) {
+      noteOccupancy(ring_.capacity());
+      return false;
+    }
+    if ((++pushes_.var % OCCUPANCY_SAMPLE) == 0) noteOccupancy(ring_.size());
+    return true;
+  }
+
+  /**
+   * @brief Pop the oldest element and record its queueing latency
+   *
+   * @return true if an element was available, false if buffer was empty
+   */
+  bool pop(Q_TYPE &out) noexcept {
+    std::optional<Stamped> s = ring_.pop();
+    if (!s) return false;
+    latency_.record(Clock::now() - s->stamp);
+    out = std::move(s->value);
+    return true;
+  }
+
+  /**
+   * @brief Blocking push; see RingMaster::push_wait()
+   *
+   * The element is built before waiting, and an exception from building it
+   * propagates; the timestamp is taken once a slot is free. Occupancy is
+   * noted as full only when the first attempt finds no room.
+   *
+   * @return true once the value is pushed, false if the ring was found
+   * full after close()
+   */
+  template<typename ENQ_TYPE>
+  bool push_wait(ENQ_TYPE &&value, size_t spin_limit = 1024) noexcept(NothrowBuild<ENQ_TYPE>) {
+    Stamped s{0, Q_TYPE(std::forward<ENQ_TYPE>(value))};
+    if (ring_.push(Restamp{s})) {
+      ring_.wakeConsumer();
+    } else {
+      noteOccupancy(ring_.capacity());
+      if (!ring_.push_wait(Restamp{s}, spin_limit)) return false;
+    }
+    if ((++pushes_.var % OCCUPANCY_SAMPLE) == 0) noteOccupancy(ring_.size());
+    return true;
+  }
+
+  /**
+   * @brief Blocking pop; see RingMaster::pop_wait()
+   *
+   * Latency is only recorded for elements actually popped.
+   *
+   * @return true on successful pop, false once the ring is closed and
+   * drained
+   */
+  bool pop_wait(Q_TYPE &out, size_t spin_limit = 1024) noexcept {
+    std::optional<Stamped> s;
+    if (!ring_.pop_wait(s, spin_limit)) return false;
+    latency_.record(Clock::now() - s->stamp);
+    out = std::move(s->value);
+    return true;
+  }
+
+  /**
+   * @brief Make the waiting calls return instead of waiting; see RingMaster::close()
+   */
+  void close() noexcept { ring_.close(); }
+
+  bool isClosed() const noexcept { return ring_.isClosed(); }
+
+  bool   isEmpty() const noexcept { return ring_.isEmpty(); }
+  bool   isFull() const noexcept { return ring_.isFull(); }
+  size_t size() const noexcept { return ring_.size(); }
+  size_t capacity() const noexcept { return ring_.capacity(); }
+
+  /**
+   * @brief Statistics policy of the underlying ring
+   */
+  const Stats &stats() const noexcept { return ring_.stats(); }
+
+  /**
+   * @brief Consumer-side latency histogram, in Clock ticks
+   */
+  const Histogram &latency() const noexcept { return latency_; }
+
+  /**
+   * @brief Convert Clock ticks (e.g. a percentile) to nanoseconds
+   */
+  static double toNanos(uint64_t ticks) noexcept {
+    return static_cast<double>(ticks) * Clock::nanosPerTick();
+  }
+
+  /**
+   * @brief Largest occupancy observed by the producer's samples
+   */
+  size_t occupancyHighWater() const noexcept {
+    return high_water_.var.load(std::memory_order_relaxed);
+  }
+
+private:
+  void noteOccupancy(size_t occupancy) noexcept {
+    if (occupancy > high_water_.var.load(std::memory_order_relaxed)) {
+      high_water_.var.store(occupancy, std::memory_order_relaxed);
+    }
+  }
+};
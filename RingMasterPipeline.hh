@@ -0,0 +1,364 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "RingMaster.hh"
+#include "RingMasterTopology.hh"
+
+/**
+ * @brief Multi-stage dataflow built from RingMaster queues
+ *
+ * This header defines ringmaster::Pipeline, a small runtime for linear
+ * pipelines such as decode -> normalize -> enrich -> publish. Each stage is
+ * a callable run on its own thread, optionally pinned to a core, and every
+ * pair of neighbouring stages is connected by an SPSC RingMaster. Stages
+ * drain their input in batches with pop_n() and forward their results with
+ * push_n(), so a ring's indices are published once per batch rather than
+ * once per element.
+ *
+ * The stage callables are stored in a std::tuple and each stage thread is
+ * instantiated for its own index, so a stage call is a direct (inlinable)
+ * call; there is no virtual dispatch or type erasure on the hot path.
+ *
+ * @section Stages
+ * Stage i receives an element of its input type by reference. Its return
+ * type defines the input type of stage i + 1:
+ * - `U` forwards one U per input element;
+ * - `std::optional<U>` forwards a U, or drops the element on std::nullopt;
+ * - `void` is only allowed for the last stage, which consumes the stream.
+ *
+ * @section Usage
+ * @code
+ * auto pipeline = ringmaster::makePipeline<Packet, 1024>(
+ *     [](Packet &p) noexcept { return decode(p); },   // Packet -> std::optional<Msg>
+ *     [](Msg &m) noexcept { return normalize(m); },   // Msg -> Msg
+ *     [](Msg &m) noexcept { publish(m); });           // sink
+ * pipeline.start({2, 3, 4});
+ *
+ * while (auto packet = nic.read()) pipeline.push_wait(*packet);
+ * pipeline.close(); // stages drain and exit in order
+ * pipeline.join();
+ * @endcode
+ *
+ * @note Stage callables must not throw. Every element type must be
+ * default-constructible, since stages keep a batch of them on their stack.
+ */
+
+namespace ringmaster {
+
+/**
+ * @struct StageReport
+ * @brief Snapshot of one stage's progress, returned by Pipeline::report()
+ */
+struct StageReport {
+  uint64_t items     = 0;   /**< Input elements processed */
+  uint64_t batches   = 0;   /**< Input batches processed */
+  uint64_t idle      = 0;   /**< Times the stage found its input ring empty */
+  size_t   occupancy = 0;   /**< Elements waiting in the input ring */
+  size_t   capacity  = 0;   /**< Capacity of the input ring */
+  double   rate      = 0.0; /**< Items per second since start() */
+};
+
+namespace detail {
+
+/**
+ * @brief Element type forwarded by a stage returning R
+ */
+template<typename R> struct StageOutput {
+  using type                    = R;
+  static constexpr bool filters = false;
+};
+
+template<typename R> struct StageOutput<std::optional<R>> {
+  using type                    = R;
+  static constexpr bool filters = true;
+};
+
+/**
+ * @brief Input type of every stage, as a std::tuple
+ */
+template<typename IN, typename... STAGES> struct PipelineEdges;
+
+template<typename IN, typename LAST> struct PipelineEdges<IN, LAST> {
+  static_assert(std::is_void_v<std::invoke_result_t<LAST &, IN &>>,
+      "The last pipeline stage must return void");
+  using type = std::tuple<IN>;
+};
+
+template<typename IN, typename FIRST, typename SECOND, typename... REST>
+struct PipelineEdges<IN, FIRST, SECOND, REST...> {
+  using Result = std::invoke_result_t<FIRST &, IN &>;
+  static_assert(!std::is_void_v<Result>, "Only the last pipeline stage may return void");
+  using Rest = typename PipelineEdges<typename StageOutput<Result>::type, SECOND, REST...>::type;
+  using type = decltype(std::tuple_cat(std::declval<std::tuple<IN>>(), std::declval<Rest>()));
+};
+
+} // namespace detail
+
+/**
+ * @class Pipeline
+ * @brief Linear chain of stage threads connected by SPSC rings
+ *
+ * Ring i feeds stage i; the caller is the producer of ring 0. Shutdown
+ * cascades: close() closes ring 0, and every stage closes its output ring
+ * once its input is closed and drained, so all elements pushed before
+ * close() reach the last stage.
+ *
+ * Each stage records its counters on its own cache line. They are updated
+ * once per batch with relaxed stores, since the stage is their only writer.
+ *
+ * @tparam IN Element type pushed into the first stage
+ * @tparam Capacity Capacity of every ring
+ * @tparam Batch Maximum number of elements a stage takes per batch
+ * @tparam STAGES Stage callables, in pipeline order
+ */
+template<typename IN, size_t Capacity, size_t Batch, typename... STAGES> class Pipeline {
+  static_assert(sizeof...(STAGES) >= 1, "A pipeline needs at least one stage");
+  static_assert(Batch >= 1, "Stages must take at least one element per batch");
+
+public:
+  static constexpr size_t Stages = sizeof...(STAGES);
+
+private:
+  using Edges = typename detail::PipelineEdges<IN, STAGES...>::type;
+
+  template<size_t I> using Edge = std::tuple_element_t<I, Edges>;
+  template<typename T> using Ring = RingMaster<T, Capacity, true>;
+
+  template<typename> struct RingsOf;
+  template<typename... TYPES> struct RingsOf<std::tuple<TYPES...>> {
+    using type = std::tuple<Ring<TYPES>...>;
+  };
+
+  /**
+   * @struct Counters
+   * @brief Counters written by one stage thread
+   */
+  struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) Counters {
+    std::atomic<uint64_t> items{0};   /**< Input elements processed */
+    std::atomic<uint64_t> batches{0}; /**< Input batches processed */
+    std::atomic<uint64_t> idle{0};    /**< Times the input ring was found empty */
+  };
+
+  typename RingsOf<Edges>::type         rings_;            /**< Ring i feeds stage i */
+  std::tuple<STAGES...>                 stages_;           /**< Stage callables */
+  Counters                              counters_[Stages]; /**< Per-stage progress */
+  std::array<std::thread, Stages>       threads_;          /**< One thread per stage */
+  std::chrono::steady_clock::time_point started_{};        /**< Set by start() */
+
+  /** Single-writer increment; cheaper than a locked fetch_add */
+  static void bump(std::atomic<uint64_t> &counter, uint64_t by) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Push `count` elements, waiting while `ring` is full
+   *
+   * push_n() does not wake a consumer parked on the ring, so every
+   * non-empty push_n() is followed by wakeConsumer() before push_wait() can
+   * park this stage on the now full ring. The last element goes through
+   * push_wait(), which wakes the consumer once the whole batch is visible.
+   */
+  template<typename T> static void forward(Ring<T> &ring, T *items, size_t count) noexcept {
+    if (count == 0) return;
+    size_t done = 0;
+    while (done + 1 < count) {
+      const size_t pushed = ring.push_n(std::make_move_iterator(items + done), count - 1 - done);
+      if (pushed) ring.wakeConsumer();
+      done += pushed;
+      if (done + 1 < count) ring.push_wait(std::move(items[done++])); // full: wait for a slot
+    }
+    ring.push_wait(std::move(items[count - 1]));
+  }
+
+  // Stack budget for the input and output batch buffers of one stage thread
+  static constexpr size_t StageStackBytes = size_t(1) << 20;
+
+  /** Bytes of stack the batch buffers of stage I take */
+  template<size_t I> static constexpr size_t batch_bytes() noexcept {
+    if constexpr (I + 1 == Stages) {
+      return Batch * sizeof(Edge<I>);
+    } else {
+      return Batch * (sizeof(Edge<I>) + sizeof(Edge<I + 1>));
+    }
+  }
+
+  /**
+   * @brief Body of the thread running stage I
+   */
+  template<size_t I> void run() noexcept {
+    static_assert(batch_bytes<I>() <= StageStackBytes,
+        "A stage's batch buffers live on its thread's stack; lower Batch");
+
+    auto     &in    = std::get<I>(rings_);
+    auto     &stage = std::get<I>(stages_);
+    Counters &stats = counters_[I];
+    Edge<I>   batch[Batch];
+
+    while (true) {
+      // The first element goes through pop_wait(), which waits while the
+      // ring is empty and wakes a producer parked on a full ring
+      if (in.isEmpty()) bump(stats.idle, 1);
+      if (!in.pop_wait(batch[0])) break; // closed and drained
+      const size_t extra = in.pop_n(batch + 1, Batch - 1);
+      if (extra) in.wakeProducer(); // pop_n() frees slots without waking
+      const size_t n = 1 + extra;
+
+      if constexpr (I + 1 == Stages) {
+        for (size_t i = 0; i < n; ++i) stage(batch[i]);
+      } else {
+        using Out    = Edge<I + 1>;
+        using Result = std::invoke_result_t<decltype(stage), Edge<I> &>;
+        Out    out[Batch];
+        size_t m = 0;
+        for (size_t i = 0; i < n; ++i) {
+          if constexpr (detail::StageOutput<Result>::filters) {
+            if (auto result = stage(batch[i])) out[m++] = std::move(*result);
+          } else {
+            out[m++] = stage(batch[i]);
+          }
+        }
+        forward<Out>(std::get<I + 1>(rings_), out, m);
+      }
+      bump(stats.items, n);
+      bump(stats.batches, 1);
+    }
+
+    if constexpr (I + 1 < Stages) std::get<I + 1>(rings_).close();
+  }
+
+  template<size_t I> StageReport report_one(double seconds) const noexcept {
+    const auto &in = std::get<I>(rings_);
+    StageReport r;
+    r.items     = counters_[I].items.load(std::memory_order_relaxed);
+    r.batches   = counters_[I].batches.load(std::memory_order_relaxed);
+    r.idle      = counters_[I].idle.load(std::memory_order_relaxed);
+    r.occupancy = in.size();
+    r.capacity  = in.capacity();
+    r.rate      = (seconds > 0) ? r.items / seconds : 0.0;
+    return r;
+  }
+
+  template<size_t... I>
+  void start_all(const std::vector<int> &cpus, std::index_sequence<I...>) {
+    ((threads_[I] = std::thread([this, cpu = (I < cpus.size()) ? cpus[I] : -1]() noexcept {
+      if (cpu >= 0) pinCurrentThread(cpu);
+      run<I>();
+    })),
+        ...);
+  }
+
+  template<size_t... I>
+  std::array<StageReport, Stages> report_all(double seconds, std::index_sequence<I...>) const {
+    return {report_one<I>(seconds)...};
+  }
+
+public:
+  /**
+   * @param stages Stage callables, in pipeline order
+   */
+  explicit Pipeline(STAGES... stages) : stages_(std::move(stages)...) {}
+
+  /**
+   * @brief Close the input and wait for every stage to finish
+   */
+  ~Pipeline() {
+    close();
+    join();
+  }
+
+  // Non-copyable, non-movable: stage threads refer to the rings
+  Pipeline(const Pipeline &)            = delete;
+  Pipeline &operator=(const Pipeline &) = delete;
+
+  /**
+   * @brief Launch one thread per stage
+   *
+   * @param cpus CPU to pin stage i to, for each i; negative or missing
+   * entries leave that stage unpinned
+   * @throws std::system_error if a thread cannot be started
+   */
+  void start(const std::vector<int> &cpus = {}) {
+    started_ = std::chrono::steady_clock::now();
+    start_all(cpus, std::make_index_sequence<Stages>{});
+  }
+
+  /**
+   * @brief Feed one element to the first stage without waiting
+   *
+   * @return true if the element was queued, false if ring 0 was full or the
+   * pipeline is closed
+   */
+  template<typename ENQ_TYPE> bool push(ENQ_TYPE &&value) noexcept {
+    auto &in = std::get<0>(rings_);
+    if (in.isClosed()) return false;
+    if (!in.push(std::forward<ENQ_TYPE>(value))) return false;
+    in.wakeConsumer();
+    return true;
+  }
+
+  /**
+   * @brief Feed one element to the first stage, waiting while ring 0 is full
+   *
+   * @return true once queued, false if the pipeline is closed
+   */
+  template<typename ENQ_TYPE> bool push_wait(ENQ_TYPE &&value) noexcept {
+    auto &in = std::get<0>(rings_);
+    if (in.isClosed()) return false;
+    return in.push_wait(std::forward<ENQ_TYPE>(value));
+  }
+
+  /**
+   * @brief Stop accepting input; stages finish what was already pushed
+   */
+  void close() noexcept { std::get<0>(rings_).close(); }
+
+  /**
+   * @brief Wait for every started stage thread to exit
+   */
+  void join() noexcept {
+    for (std::thread &t : threads_) {
+      if (t.joinable()) t.join();
+    }
+  }
+
+  /**
+   * @brief Per-stage counters, input occupancy and throughput
+   *
+   * The stage with the highest occupancy (and lowest idle count) is the
+   * bottleneck: its input ring fills while the stages after it starve.
+   */
+  std::array<StageReport, Stages> report() const {
+    // Rates stay zero until start() has set the reference time
+    double seconds = 0.0;
+    if (started_ != std::chrono::steady_clock::time_point{}) {
+      seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+    }
+    return report_all(seconds, std::make_index_sequence<Stages>{});
+  }
+};
+
+/**
+ * @brief Build a Pipeline, deducing the stage types
+ *
+ * @tparam IN Element type pushed into the first stage
+ * @tparam Capacity Capacity of every ring
+ * @tparam Batch Maximum number of elements a stage takes per batch
+ */
+template<typename IN, size_t Capacity, size_t Batch = 64, typename... STAGES>
+Pipeline<IN, Capacity, Batch, std::decay_t<STAGES>...> makePipeline(STAGES &&...stages) {
+  return Pipeline<IN, Capacity, Batch, std::decay_t<STAGES>...>(std::forward<STAGES>(stages)...);
+}
+
+} // namespace ringmaster
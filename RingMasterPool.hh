@@ -0,0 +1,198 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Ring of buffer handles with an integrated, allocation-free pool
+ *
+ * This header defines PooledRingMaster, which moves large payloads (4 KB
+ * and up) between two threads without copying them through the ring and
+ * without touching the allocator. A fixed pool of cache-aligned buffers is
+ * built once. The producer takes a free buffer, fills it in place and
+ * publishes its address through a RingMaster of pointers. The consumer reads
+ * it in place and hands the address back through a second, reverse
+ * RingMaster. Buffers circulate in a closed loop, so steady state performs
+ * no allocation, no cross-thread free and only pointer-sized ring traffic.
+ *
+ * @section Usage
+ * @code
+ * PooledRingMaster<Frame, 256> frames;
+ *
+ * // producer
+ * Frame *f = frames.acquire_wait();
+ * capture(*f);
+ * frames.publish(f);
+ *
+ * // consumer
+ * frames.consume_all([](Frame &f) noexcept { encode(f); });
+ * @endcode
+ *
+ * @note The pool lives inside the object (Capacity buffers of Q_TYPE), like
+ * RingMaster's static storage; give large pools static or heap storage.
+ */
+
+/**
+ * @class PooledRingMaster
+ * @brief SPSC hand-off of pooled buffers through a pair of pointer rings
+ *
+ * Every buffer is always in exactly one place: the free ring, the producer's
+ * hands, the full ring, or the consumer's hands. Both rings therefore have
+ * room for the whole pool, and publish() and release() never fail.
+ *
+ * Buffers are default-constructed once, when the pool is built, and are
+ * reused as-is afterwards; the producer overwrites whatever it needs.
+ *
+ * @tparam Q_TYPE Buffer type; must be default-constructible
+ * @tparam Capacity Number of buffers in the pool; must be a power of two
+ * @tparam WaitStrategy Policy used by the waiting calls (see
+ * ringmaster::HybridWait)
+ */
+template<typename Q_TYPE, size_t Capacity, typename WaitStrategy = ringmaster::HybridWait<>>
+class PooledRingMaster {
+  static_assert(std::is_default_constructible_v<Q_TYPE>, "Pooled buffers are built up front");
+
+  using Ring = RingMaster<Q_TYPE *, Capacity, true, WaitStrategy>;
+
+  /**
+   * @struct Slot
+   * @brief One pooled buffer, so neighbouring buffers never share a line
+   */
+  struct alignas(DESTRUCTIVE_INTERFERENCE_SIZE) Slot {
+    Q_TYPE value;
+  };
+
+  // Pointers returned to the free ring by one consume_all() step
+  static constexpr size_t ReleaseBatch = 64;
+
+  Ring full_;           /**< Producer to consumer: published buffers */
+  Ring free_;           /**< Consumer to producer: buffers ready for reuse */
+  Slot pool_[Capacity]; /**< The buffers themselves */
+
+  /**
+   * @brief Push `count` pointers with a single wake-up of the other side
+   *
+   * The waiting call on the last pointer checks for a parked peer once,
+   * after every pointer in the batch is visible.
+   */
+  static void hand_over(Ring &ring, Q_TYPE *const *items, size_t count) noexcept {
+    if (count == 0) return;
+    ring.push_n(items, count - 1);
+    ring.push_wait(items[count - 1]);
+  }
+
+public:
+  /**
+   * @brief Build every buffer and put it on the free ring
+   */
+  PooledRingMaster() {
+    for (Slot &slot : pool_) free_.push(&slot.value);
+  }
+
+  // Non-copyable, non-movable: buffers are handed out by address
+  PooledRingMaster(const PooledRingMaster &)            = delete;
+  PooledRingMaster &operator=(const PooledRingMaster &) = delete;
+
+  /**
+   * @brief Take a free buffer (producer side)
+   *
+   * @return A buffer to fill, or nullptr if every buffer is in flight
+   */
+  Q_TYPE *acquire() noexcept {
+    Q_TYPE *buffer;
+    return free_.pop(buffer) ? buffer : nullptr;
+  }
+
+  /**
+   * @brief Take a free buffer, waiting according to WaitStrategy
+   *
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   */
+  Q_TYPE *acquire_wait(size_t spin_limit = 1024) noexcept {
+    Q_TYPE *buffer;
+    free_.pop_wait(buffer, spin_limit);
+    return buffer;
+  }
+
+  /**
+   * @brief Hand a filled buffer to the consumer (producer side)
+   *
+   * @param buffer Buffer obtained from acquire() or acquire_wait()
+   */
+  void publish(Q_TYPE *buffer) noexcept { full_.push_wait(buffer); }
+
+  /**
+   * @brief Hand `count` filled buffers to the consumer with one wake-up
+   */
+  void publish_n(Q_TYPE *const *buffers, size_t count) noexcept {
+    hand_over(full_, buffers, count);
+  }
+
+  /**
+   * @brief Take the oldest published buffer (consumer side)
+   *
+   * @return The buffer, or nullptr if nothing is published; pass it to
+   * release() when done
+   */
+  Q_TYPE *receive() noexcept {
+    Q_TYPE *buffer;
+    return full_.pop(buffer) ? buffer : nullptr;
+  }
+
+  /**
+   * @brief Take the oldest published buffer, waiting according to WaitStrategy
+   *
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   */
+  Q_TYPE *receive_wait(size_t spin_limit = 1024) noexcept {
+    Q_TYPE *buffer;
+    full_.pop_wait(buffer, spin_limit);
+    return buffer;
+  }
+
+  /**
+   * @brief Return a buffer to the pool (consumer side)
+   *
+   * @param buffer Buffer obtained from receive() or receive_wait()
+   */
+  void release(Q_TYPE *buffer) noexcept { free_.push_wait(buffer); }
+
+  /**
+   * @brief Visit up to `max` published buffers in place, then release them
+   *
+   * Buffers are returned to the free ring in groups, each with one index
+   * update and at most one wake-up of a waiting producer.
+   *
+   * @tparam F Callable accepting Q_TYPE &; must not throw
+   * @param visitor Called once per buffer
+   * @param max Maximum number of buffers to visit
+   * @return Number of buffers visited
+   */
+  template<typename F> size_t consume_all(F &&visitor, size_t max = Capacity) noexcept {
+    Q_TYPE *done[ReleaseBatch];
+    size_t  total = 0;
+    while (total < max) {
+      const size_t want = (max - total < ReleaseBatch) ? max - total : ReleaseBatch;
+      const size_t n    = full_.pop_n(done, want);
+      for (size_t i = 0; i < n; ++i) visitor(*done[i]);
+      hand_over(free_, done, n);
+      total += n;
+      if (n < want) break;
+    }
+    return total;
+  }
+
+  /**
+   * @brief Number of published buffers; may be stale under concurrency
+   */
+  size_t size() const noexcept { return full_.size(); }
+
+  /**
+   * @brief Number of buffers ready for acquire(); may be stale under concurrency
+   */
+  size_t available() const noexcept { return free_.size(); }
+
+  static constexpr size_t capacity() noexcept { return Capacity; }
+};
@@ -0,0 +1,213 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief One consumer thread waiting on many rings
+ *
+ * This header defines RingSelector, which lets a single consumer service a
+ * set of SPSC rings of the same type (e.g. one per client session) without
+ * polling each of them. Producers push through the selector, which sets the
+ * ring's bit in a shared readiness bitmap on the empty-to-ready transition.
+ * The consumer swaps the bitmap words out, drains only the rings whose bits
+ * were set, and parks on a single futex while the whole bitmap is clear.
+ * Idle cost and wake-up latency therefore depend on the number of bitmap
+ * words, not on the number of rings.
+ *
+ * @section Usage
+ * @code
+ * RingMaster<Msg, 1024> sessions[32];
+ * ringmaster::RingSelector<RingMaster<Msg, 1024>> selector;
+ * for (auto &ring : sessions) selector.add(ring);
+ *
+ * // producer of session `id`
+ * selector.push(id, msg);
+ *
+ * // consumer
+ * for (;;) selector.wait([](size_t id, Msg &m) noexcept { handle(id, m); });
+ * @endcode
+ *
+ * @note Register every ring with add() before producers start. Producers
+ * that push to a ring directly must call signal(id) afterwards, or the
+ * consumer will not notice the element.
+ */
+
+namespace ringmaster {
+
+/**
+ * @class RingSelector
+ * @brief Readiness bitmap and single parking spot over up to MaxRings rings
+ *
+ * Each ring has one bit. A producer checks its bit with a plain load after a
+ * fence and only issues the fetch_or (and, if the consumer is parked, the
+ * futex wake) when the bit is clear, so a busy ring costs one fence and one
+ * load per push. The consumer clears a word with an exchange before draining
+ * its rings, and sets a bit again when a ring still holds elements after
+ * its batch, so a busy ring cannot starve the others.
+ *
+ * @tparam RING Ring type; must provide push() and consume_all(visitor, max)
+ * @tparam MaxRings Maximum number of rings that can be registered
+ * @tparam WaitStrategy Policy deciding how wait() spends the time before it
+ * parks (see ringmaster::HybridWait)
+ */
+template<typename RING, size_t MaxRings = 64, typename WaitStrategy = HybridWait<>>
+class RingSelector {
+  static_assert(MaxRings >= 1, "A selector needs room for at least one ring");
+
+  // Number of 64-bit readiness words
+  static constexpr size_t Words = (MaxRings + 63) / 64;
+
+  alignas(DESTRUCTIVE_INTERFERENCE_SIZE) std::atomic<uint64_t> ready_[Words]; /**< Ring bits */
+  PaddedFlag consumer_waiting_{}; /**< Raised by wait() while every bit is clear */
+
+  RING  *rings_[MaxRings]; /**< Registered rings, indexed by id */
+  size_t count_ = 0;       /**< Number of registered rings */
+
+  /**
+   * @brief Park until a producer sets a bit
+   *
+   * Same handshake as RingMaster::park(): the flag is raised and the bitmap
+   * re-checked after a fence that pairs with the one in signal().
+   */
+  void park() noexcept {
+    consumer_waiting_.var.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!anyReady()) consumer_waiting_.var.wait(1, std::memory_order_acquire);
+    consumer_waiting_.var.store(0, std::memory_order_relaxed);
+  }
+
+public:
+  using Ring = RING;
+
+  RingSelector() noexcept {
+    for (auto &word : ready_) word.store(0, std::memory_order_relaxed);
+  }
+
+  // Non-copyable, non-movable
+  RingSelector(const RingSelector &)            = delete;
+  RingSelector &operator=(const RingSelector &) = delete;
+
+  /**
+   * @brief Register a ring
+   *
+   * @param ring Ring to watch; must outlive the selector
+   * @return Id to pass to push(), signal() and the drain visitor
+   * @throws std::length_error if MaxRings rings are already registered
+   */
+  size_t add(RING &ring) {
+    if (count_ == MaxRings) throw std::length_error("RingSelector is full");
+    rings_[count_] = &ring;
+    return count_++;
+  }
+
+  /**
+   * @brief Push to ring `id` and mark it ready
+   *
+   * @return true if insertion succeeded, false if that ring was full
+   */
+  template<typename ENQ_TYPE> bool push(size_t id, ENQ_TYPE &&value) noexcept {
+    if (!rings_[id]->push(std::forward<ENQ_TYPE>(value))) return false;
+    signal(id);
+    return true;
+  }
+
+  /**
+   * @brief Mark ring `id` ready after an element was pushed to it
+   *
+   * Free when the bit is already set; otherwise sets it and wakes the
+   * consumer if it is parked.
+   */
+  void signal(size_t id) noexcept {
+    std::atomic<uint64_t> &word = ready_[id / 64];
+    const uint64_t         bit  = uint64_t(1) << (id % 64);
+
+    // Orders the element's publication before the bit check; pairs with
+    // the fence in drain()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (word.load(std::memory_order_relaxed) & bit) return;
+    if (word.fetch_or(bit, std::memory_order_release) & bit) return;
+
+    if constexpr (!WaitStrategy::parks) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.var.load(std::memory_order_relaxed) &&
+        consumer_waiting_.var.exchange(0, std::memory_order_relaxed)) {
+      consumer_waiting_.var.notify_one();
+    }
+  }
+
+  /**
+   * @brief Drain every ready ring once without blocking
+   *
+   * @tparam F Callable accepting (size_t id, element &); must not throw
+   * @param visitor Called once per element, ring by ring
+   * @param batch Maximum number of elements taken from one ring per call
+   * @return Number of elements visited
+   */
+  template<typename F> size_t drain(F &&visitor, size_t batch = RING::DefaultBatch) noexcept {
+    size_t total = 0;
+    for (size_t w = 0; w < Words; ++w) {
+      if (ready_[w].load(std::memory_order_relaxed) == 0) continue;
+      uint64_t bits = ready_[w].exchange(0, std::memory_order_acquire);
+
+      // Orders the clear before reading the rings; pairs with signal()
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      uint64_t again = 0;
+      while (bits) {
+        const size_t bit = std::countr_zero(bits);
+        const size_t id  = w * 64 + bit;
+        bits &= bits - 1;
+
+        const size_t n = rings_[id]->consume_all(
+            [&visitor, id](auto &elem) noexcept { visitor(id, elem); }, batch);
+        total += n;
+        if (n == batch) again |= uint64_t(1) << bit; // may hold more
+      }
+      if (again) ready_[w].fetch_or(again, std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  /**
+   * @brief Drain ready rings, waiting according to WaitStrategy while none is
+   *
+   * @param visitor See drain()
+   * @param batch See drain()
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return Number of elements visited (always at least one)
+   */
+  template<typename F>
+  size_t wait(F &&visitor, size_t batch = RING::DefaultBatch, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (true) {
+      if (const size_t n = drain(visitor, batch)) return n;
+      if (waiter.spin()) continue;
+      park();
+      waiter = WaitStrategy(spin_limit);
+    }
+  }
+
+  /**
+   * @brief Check if any ring is marked ready; may be stale under concurrency
+   */
+  bool anyReady() const noexcept {
+    for (const auto &word : ready_) {
+      if (word.load(std::memory_order_relaxed)) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Number of registered rings
+   */
+  size_t size() const noexcept { return count_; }
+
+  static constexpr size_t capacity() noexcept { return MaxRings; }
+};
+
+} // namespace ringmaster
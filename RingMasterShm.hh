@@ -0,0 +1,744 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <linux/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Inter-process SPSC ring buffer over a POSIX shared-memory segment
+ *
+ * This header defines ShmRingMaster, which places the ring's indices, its
+ * waiter flags and the slot array in one named shared-memory segment so
+ * that a producer and a consumer living in different processes exchange
+ * elements exactly as the in-process RingMaster does: one element copy in,
+ * one element copy out, no serialization.
+ *
+ * @section Layout
+ * The segment starts with a versioned ShmRingHeader recording capacity,
+ * element size and alignment, and the CACHE_LINE_SIZE and
+ * DESTRUCTIVE_INTERFERENCE_SIZE the creator was built with. A process
+ * compiled with a different element type or cache geometry refuses to
+ * attach. The header is followed by one interference-sized block each for
+ * head, tail, the durable head of a journal and the two waiter flags, then
+ * the slots.
+ *
+ * @section Usage
+ * @code
+ * // feed handler
+ * auto ring = ShmRingMaster<Tick>::create("/ticks", 1 << 16);
+ * ring.push_wait(tick);
+ *
+ * // strategy engine
+ * auto ring = ShmRingMaster<Tick>::open("/ticks");
+ * Tick t;
+ * ring.pop_wait(t);
+ * @endcode
+ *
+ * @section Journal
+ * createFile() and openFile() put the same layout in a regular file
+ * instead, so the ring doubles as a crash-recovery journal: head, tail and
+ * every unconsumed slot survive a restart of either process, and a
+ * restarted consumer resumes at the persisted tail and catches up on the
+ * backlog. Push and pop are unchanged, so journaling costs no extra write
+ * per element. A consumer that wants at-least-once delivery processes
+ * elements in place with consume_all(), which advances tail only after the
+ * visitor returns. The Durability mode selects what survives a machine
+ * crash rather than a process crash:
+ * - PageCache: nothing. Kernel writeback does not order the page holding
+ * head after the slot pages it covers, so after a machine crash the file
+ * may hold a head past slots that never reached storage;
+ * - Msync: everything published before the last completed flush(),
+ * typically called from a timer or housekeeping thread. flush() syncs the
+ * slots first and only then advances a separate durable head, and
+ * openFile() in this mode resumes the producer at that durable head, so
+ * elements published after the last flush() are discarded on recovery;
+ * - MapSync: every published element. The file must be on a DAX-capable
+ * (persistent memory) filesystem, and push and pop write the touched cache
+ * lines back with CLWB/CLFLUSHOPT before publishing.
+ *
+ * @code
+ * using ringmaster::Durability;
+ * auto journal = ShmRingMaster<Order>::openFile("/pmem/orders.ring", Durability::MapSync);
+ * journal.consume_all([](const Order &o) noexcept { apply(o); });
+ * @endcode
+ *
+ * @note The roles are the same as RingMaster: exactly one producer and one
+ * consumer across all processes attached to the segment.
+ */
+
+namespace ringmaster {
+
+/**
+ * @enum Durability
+ * @brief What a file-backed ring guarantees across a machine crash
+ */
+enum class Durability : uint8_t {
+  PageCache, /**< Rely on kernel writeback; survives process crashes only */
+  Msync,     /**< Durable up to the last completed flush() */
+  MapSync,   /**< Durable on publish; needs MAP_SYNC on a DAX filesystem */
+};
+
+/**
+ * @struct ShmRingHeader
+ * @brief Versioned description of a mapped ring, stored at offset 0
+ */
+struct alignas(CACHE_LINE_SIZE) ShmRingHeader {
+  static constexpr uint64_t MAGIC   = 0x52494e474d535452ull; // "RINGMSTR"
+  static constexpr uint32_t VERSION = 3;
+
+  uint64_t              magic;             /**< MAGIC once the segment is initialized */
+  uint32_t              version;           /**< Layout version (VERSION) */
+  uint32_t              cache_line_size;   /**< CACHE_LINE_SIZE of the creating build */
+  uint32_t              interference_size; /**< DESTRUCTIVE_INTERFERENCE_SIZE (index spacing) */
+  uint64_t              capacity;          /**< Number of slots (power of two) */
+  uint64_t              element_size;      /**< sizeof(Q_TYPE) */
+  uint64_t              element_align;     /**< alignof(Q_TYPE) */
+  uint64_t              slot_offset;       /**< Byte offset of slot 0 from the segment start */
+  std::atomic<uint32_t> ready;             /**< Set with release ordering after initialization */
+};
+
+/**
+ * @struct ShmRingControl
+ * @brief Shared indices and waiter flags, each on its own cache line
+ */
+struct ShmRingControl {
+  ShmRingHeader header;           /**< Layout description */
+  PaddedAtomic  head;             /**< Producer index (next write position) */
+  PaddedAtomic  tail;             /**< Consumer index (next read position) */
+  PaddedAtomic  durable_head;     /**< Head whose slots were synced by flush() */
+  PaddedFlag    consumer_waiting; /**< Raised while the consumer is parked */
+  PaddedFlag    producer_waiting; /**< Raised while the producer is parked */
+};
+
+static_assert(std::is_standard_layout_v<ShmRingControl>, "ShmRingControl must be standard layout");
+static_assert(std::atomic<size_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+    "Process-shared indices require lock-free atomics");
+
+namespace detail {
+
+/**
+ * @brief Block while `*word == expected`, visible across processes
+ *
+ * Uses a non-private futex on Linux so that waiters in other processes
+ * mapping the same page can be woken. Elsewhere it degrades to a short sleep,
+ * after which the caller re-checks its condition.
+ */
+inline void shared_futex_wait(std::atomic<uint32_t> *word, uint32_t expected) noexcept {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+  if (word->load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+#endif
+}
+
+/**
+ * @brief Wake one process-shared waiter blocked on `word`
+ */
+inline void shared_futex_wake(std::atomic<uint32_t> *word) noexcept {
+#if defined(__linux__)
+  ::syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+/**
+ * @brief msync() the pages covering [addr, addr + bytes)
+ *
+ * @param flags MS_SYNC or MS_ASYNC
+ * @return true on success, false if msync failed (errno is set)
+ */
+inline bool sync_pages(const void *addr, size_t bytes, int flags) noexcept {
+  if (bytes == 0) return true;
+  const uintptr_t page  = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+  const uintptr_t first = reinterpret_cast<uintptr_t>(addr) & ~(page - 1);
+  return ::msync(reinterpret_cast<void *>(first),
+             reinterpret_cast<uintptr_t>(addr) + bytes - first, flags) == 0;
+}
+
+/**
+ * @brief Write the cache lines covering [addr, addr + bytes) back to memory
+ *
+ * Uses the cheapest write-back instruction the build targets (CLWB, then
+ * CLFLUSHOPT, then CLFLUSH) and ends with an SFENCE, so later stores are
+ * ordered after the data is persistent. Only meaningful on a MAP_SYNC
+ * mapping of persistent memory.
+ */
+inline void persist(const void *addr, size_t bytes) noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  auto       *line = reinterpret_cast<char *>(reinterpret_cast<uintptr_t>(addr) & ~uintptr_t(63));
+  const char *end  = static_cast<const char *>(addr) + bytes;
+  for (; line < end; line += 64) {
+#if defined(__CLWB__)
+    _mm_clwb(line);
+#elif defined(__CLFLUSHOPT__)
+    _mm_clflushopt(line);
+#else
+    _mm_clflush(line);
+#endif
+  }
+  _mm_sfence();
+#else
+  // No user-space write-back: fall back to syncing the pages
+  sync_pages(addr, bytes, MS_SYNC);
+#endif
+}
+
+} // namespace detail
+} // namespace ringmaster
+
+/**
+ * @class ShmRingMaster
+ * @brief SPSC ring living in a named POSIX shared-memory segment
+ *
+ * A handle owns one mapping of the segment. Each handle keeps process-local
+ * cached copies of the opposite index on separate cache lines, so push() and
+ * pop() only read the other side's index when the ring looks full/empty.
+ * Blocking uses process-shared futexes on the waiter flags. A handle may
+ * also map a regular file (see createFile()), in which case the ring
+ * persists across restarts.
+ *
+ * @tparam Q_TYPE Element type; must be trivially copyable and must not hold
+ * pointers into either process's address space.
+ * @tparam WaitStrategy Policy used by push_wait()/pop_wait() between failed
+ * attempts (see ringmaster::HybridWait).
+ */
+template<typename Q_TYPE, typename WaitStrategy = ringmaster::HybridWait<>> class ShmRingMaster {
+  static_assert(std::is_trivially_copyable_v<Q_TYPE>,
+      "ShmRingMaster elements are shared as raw bytes and must be trivially copyable");
+
+  using Header  = ringmaster::ShmRingHeader;
+  using Control = ringmaster::ShmRingControl;
+
+  Control *ctrl_  = nullptr; /**< Start of the mapping */
+  Q_TYPE  *slots_ = nullptr; /**< Slot array inside the mapping */
+  size_t   mask_  = 0;       /**< Capacity - 1 */
+  size_t   bytes_ = 0;       /**< Length of the mapping */
+
+  ringmaster::Durability durability_ = ringmaster::Durability::PageCache; /**< File backing mode */
+
+  ringmaster::PaddedIndex tail_cache_{}; /**< Producer's copy of the shared tail */
+  ringmaster::PaddedIndex head_cache_{}; /**< Consumer's copy of the shared head */
+
+public:
+  /**
+   * @brief Create (or replace) a segment and map it
+   *
+   * @param name POSIX shared-memory name, e.g. "/ticks"
+   * @param capacity Number of slots; must be a non-zero power of two
+   * @return Handle attached to the freshly initialized ring
+   * @throws std::invalid_argument if capacity is not a power of two
+   * @throws std::system_error if the segment cannot be created or mapped
+   */
+  static ShmRingMaster create(const std::string &name, size_t capacity) {
+    checkCapacity(capacity);
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+    return initialize(fd, name, capacity, ringmaster::Durability::PageCache);
+  }
+
+  /**
+   * @brief Map an existing segment created by create()
+   *
+   * @param name POSIX shared-memory name used by the creator
+   * @return Handle attached to the existing ring
+   * @throws std::system_error if the segment cannot be opened or mapped
+   * @throws std::runtime_error if the header does not match this build
+   */
+  static ShmRingMaster open(const std::string &name) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "shm_open " + name);
+    return reattach(fd, name, ringmaster::Durability::PageCache);
+  }
+
+  /**
+   * @brief Create (or replace) a ring journal in a regular file and map it
+   *
+   * @param path File to create; for MapSync it must be on a DAX filesystem
+   * @param capacity Number of slots; must be a non-zero power of two
+   * @param durability What survives a machine crash (see Durability)
+   * @return Handle attached to the freshly initialized, empty ring
+   * @throws std::invalid_argument if capacity is not a power of two
+   * @throws std::system_error if the file cannot be created or mapped
+   */
+  static ShmRingMaster createFile(const std::string &path,
+      size_t capacity,
+      ringmaster::Durability durability = ringmaster::Durability::PageCache) {
+    checkCapacity(capacity);
+    const int fd = ::open(path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, 0600);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "open " + path);
+    return initialize(fd, path, capacity, durability);
+  }
+
+  /**
+   * @brief Map an existing ring journal, resuming at its persisted indices
+   *
+   * The producer continues at the stored head and the consumer at the
+   * stored tail, so every element published but not consumed before the
+   * restart is still delivered. In Msync mode the producer instead resumes
+   * at the head recorded by the last completed flush(), dropping elements
+   * whose slots may not have reached storage; open the journal this way
+   * only while no producer is attached to it.
+   *
+   * @param path File written by createFile()
+   * @param durability Mode for this handle; need not match the creator's
+   * @return Handle attached to the existing ring
+   * @throws std::system_error if the file cannot be opened or mapped
+   * @throws std::runtime_error if the header does not match this build
+   */
+  static ShmRingMaster openFile(const std::string &path,
+      ringmaster::Durability durability = ringmaster::Durability::PageCache) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), "open " + path);
+    return reattach(fd, path, durability);
+  }
+
+  /**
+   * @brief Remove the segment name; existing mappings stay valid
+   */
+  static void unlink(const std::string &name) noexcept { ::shm_unlink(name.c_str()); }
+
+  ShmRingMaster(ShmRingMaster &&other) noexcept { *this = std::move(other); }
+
+  ShmRingMaster &operator=(ShmRingMaster &&other) noexcept {
+    if (this != &other) {
+      unmap();
+      ctrl_           = std::exchange(other.ctrl_, nullptr);
+      slots_          = std::exchange(other.slots_, nullptr);
+      mask_           = std::exchange(other.mask_, 0);
+      bytes_          = std::exchange(other.bytes_, 0);
+      durability_     = other.durability_;
+      tail_cache_.var = other.tail_cache_.var;
+      head_cache_.var = other.head_cache_.var;
+    }
+    return *this;
+  }
+
+  ShmRingMaster(const ShmRingMaster &)            = delete;
+  ShmRingMaster &operator=(const ShmRingMaster &) = delete;
+
+  /**
+   * @brief Unmap the segment; the shared ring itself is left intact
+   */
+  ~ShmRingMaster() { unmap(); }
+
+  /**
+   * @brief Push an element if space is available
+   *
+   * @param value Element to copy into the ring
+   * @return true if insertion succeeded, false if the ring was full
+   */
+  bool push(const Q_TYPE &value) noexcept {
+    const size_t head = ctrl_->head.var.load(std::memory_order_relaxed);
+    if (writable(head) == 0) return false;
+
+    slots_[head & mask_] = value;
+    if (durable()) ringmaster::detail::persist(slots_ + (head & mask_), sizeof(Q_TYPE));
+    publishHead(head + 1);
+    return true;
+  }
+
+  /**
+   * @brief Pop the oldest element
+   *
+   * @param out Reference where the popped element is stored
+   * @return true if an element was available, false if the ring was empty
+   */
+  bool pop(Q_TYPE &out) noexcept {
+    const size_t tail = ctrl_->tail.var.load(std::memory_order_relaxed);
+    if (readable(tail) == 0) return false;
+
+    out = slots_[tail & mask_];
+    publishTail(tail + 1);
+    return true;
+  }
+
+  /**
+   * @brief Push up to `count` elements with a single head publication
+   *
+   * @param items Pointer to the first element to copy
+   * @param count Maximum number of elements to push
+   * @return Number of elements actually pushed
+   */
+  size_t push_n(const Q_TYPE *items, size_t count) noexcept {
+    const size_t head  = ctrl_->head.var.load(std::memory_order_relaxed);
+    const size_t space = writable(head, count);
+    const size_t n     = (count > space) ? space : count;
+    if (n == 0) return 0;
+
+    const size_t idx       = head & mask_;
+    const size_t first_len = (n > capacity() - idx) ? capacity() - idx : n;
+    std::memcpy(slots_ + idx, items, first_len * sizeof(Q_TYPE));
+    std::memcpy(slots_, items + first_len, (n - first_len) * sizeof(Q_TYPE));
+    if (durable()) {
+      ringmaster::detail::persist(slots_ + idx, first_len * sizeof(Q_TYPE));
+      if (n > first_len) ringmaster::detail::persist(slots_, (n - first_len) * sizeof(Q_TYPE));
+    }
+
+    publishHead(head + n);
+    return n;
+  }
+
+  /**
+   * @brief Pop up to `count` elements with a single tail publication
+   *
+   * @param out Destination for the popped elements
+   * @param count Maximum number of elements to pop
+   * @return Number of elements actually popped
+   */
+  size_t pop_n(Q_TYPE *out, size_t count) noexcept {
+    const size_t tail  = ctrl_->tail.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail, count);
+    const size_t n     = (count > avail) ? avail : count;
+    if (n == 0) return 0;
+
+    const size_t idx       = tail & mask_;
+    const size_t first_len = (n > capacity() - idx) ? capacity() - idx : n;
+    std::memcpy(out, slots_ + idx, first_len * sizeof(Q_TYPE));
+    std::memcpy(out + first_len, slots_, (n - first_len) * sizeof(Q_TYPE));
+
+    publishTail(tail + n);
+    return n;
+  }
+
+  /**
+   * @brief Visit up to `max` elements in their slots, then release them
+   *
+   * tail advances once, after the visitor has returned for every element,
+   * so a consumer of a file-backed ring that crashes mid-batch sees the
+   * whole batch again on restart (at-least-once delivery).
+   *
+   * @tparam F Callable accepting const Q_TYPE &; must not throw
+   * @param visitor Called once per element
+   * @param max Maximum number of elements to visit
+   * @return Number of elements visited
+   */
+  template<typename F> size_t consume_all(F &&visitor, size_t max = capacity_max) noexcept {
+    const size_t tail  = ctrl_->tail.var.load(std::memory_order_relaxed);
+    const size_t avail = readable(tail, max);
+    const size_t n     = (max > avail) ? avail : max;
+    if (n == 0) return 0;
+
+    for (size_t i = 0; i < n; ++i) visitor(static_cast<const Q_TYPE &>(slots_[(tail + i) & mask_]));
+    publishTail(tail + n);
+    return n;
+  }
+
+  /**
+   * @brief Write the elements published so far, then the indices, to storage
+   *
+   * The periodic durability point of the Msync mode; call it from a timer
+   * or housekeeping thread rather than from the producer or consumer. The
+   * slots published since the previous flush() are synced first; only
+   * once they are on storage does the durable head advance and the control
+   * block follow, so a recovered journal never covers unwritten slots.
+   * Harmless, but pointless, for shared-memory segments.
+   *
+   * @param wait Block until the write-back completes (MS_SYNC). An
+   * MS_ASYNC flush only schedules the write-back and leaves the durable
+   * head where it was.
+   * @return true on success, false if msync failed (errno is set)
+   */
+  bool flush(bool wait = true) noexcept {
+    const int    flags = wait ? MS_SYNC : MS_ASYNC;
+    const size_t head  = ctrl_->head.var.load(std::memory_order_acquire);
+    const size_t from  = ctrl_->durable_head.var.load(std::memory_order_relaxed);
+    if (!syncSlots(from, head, flags)) return false;
+    if (wait) ctrl_->durable_head.var.store(head, std::memory_order_relaxed);
+    return ringmaster::detail::sync_pages(ctrl_, sizeof(Control), flags);
+  }
+
+  /**
+   * @brief Durability mode this handle was mapped with
+   */
+  ringmaster::Durability durability() const noexcept { return durability_; }
+
+  /**
+   * @brief Push, waiting according to WaitStrategy while the ring is full
+   *
+   * @param value Element to copy into the ring
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   */
+  void push_wait(const Q_TYPE &value, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (!push(value)) {
+      if (waiter.spin()) continue;
+      park(ctrl_->producer_waiting, [this]() { return !isFull(); });
+      waiter = WaitStrategy(spin_limit);
+    }
+    wake(ctrl_->consumer_waiting);
+  }
+
+  /**
+   * @brief Pop, waiting according to WaitStrategy while the ring is empty
+   *
+   * @param out Reference that receives the popped element
+   * @param spin_limit Spin budget handed to WaitStrategy (default 1024)
+   * @return true on successful pop (always returns true eventually)
+   */
+  bool pop_wait(Q_TYPE &out, size_t spin_limit = 1024) noexcept {
+    WaitStrategy waiter(spin_limit);
+    while (!pop(out)) {
+      if (waiter.spin()) continue;
+      park(ctrl_->consumer_waiting, [this]() { return !isEmpty(); });
+      waiter = WaitStrategy(spin_limit);
+    }
+    wake(ctrl_->producer_waiting);
+    return true;
+  }
+
+  bool isEmpty() const noexcept { return size() == 0; }
+
+  bool isFull() const noexcept { return size() >= capacity(); }
+
+  size_t size() const noexcept {
+    const size_t head = ctrl_->head.var.load(std::memory_order_acquire);
+    const size_t tail = ctrl_->tail.var.load(std::memory_order_acquire);
+    return head - tail;
+  }
+
+  size_t capacity() const noexcept { return mask_ + 1; }
+
+private:
+  // Default consume_all() budget: everything that is readable
+  static constexpr size_t capacity_max = ~size_t(0);
+
+  /**
+   * @brief Map `bytes` of the segment behind `fd`; closes the descriptor
+   *
+   * @throws std::system_error if the mapping fails, e.g. with EOPNOTSUPP
+   * when MapSync is requested for a file outside a DAX filesystem
+   */
+  ShmRingMaster(int fd, size_t bytes, ringmaster::Durability durability)
+      : durability_(durability) {
+    int flags = MAP_SHARED;
+    if (durability == ringmaster::Durability::MapSync) {
+#if defined(MAP_SYNC) && defined(MAP_SHARED_VALIDATE)
+      flags = MAP_SHARED_VALIDATE | MAP_SYNC;
+#else
+      ::close(fd);
+      throw std::system_error(EOPNOTSUPP, std::generic_category(), "mmap MAP_SYNC");
+#endif
+    }
+    void     *mem = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+    const int err = errno;
+    ::close(fd);
+    if (mem == MAP_FAILED) throw std::system_error(err, std::generic_category(), "mmap");
+    ctrl_  = static_cast<Control *>(mem);
+    bytes_ = bytes;
+  }
+
+  static void checkCapacity(size_t capacity) {
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+      throw std::invalid_argument("ShmRingMaster capacity must be a non-zero power of two");
+    }
+  }
+
+  /**
+   * @brief Size the object behind `fd`, map it and write a fresh header
+   */
+  static ShmRingMaster initialize(
+      int fd, const std::string &name, size_t capacity, ringmaster::Durability durability) {
+    const size_t offset = slotOffset();
+    const size_t bytes  = offset + capacity * sizeof(Q_TYPE);
+
+    if (::ftruncate(fd, 0) != 0 || ::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+      const int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), "ftruncate " + name);
+    }
+
+    ShmRingMaster ring(fd, bytes, durability);
+    Header       &h   = ring.ctrl_->header;
+    h.version           = Header::VERSION;
+    h.cache_line_size   = CACHE_LINE_SIZE;
+    h.interference_size = DESTRUCTIVE_INTERFERENCE_SIZE;
+    h.capacity          = capacity;
+    h.element_size      = sizeof(Q_TYPE);
+    h.element_align     = alignof(Q_TYPE);
+    h.slot_offset       = offset;
+    h.magic             = Header::MAGIC;
+    ring.attach();
+    h.ready.store(1, std::memory_order_release);
+
+    // A journal must not be reopened with a header that never reached storage
+    if (durability == ringmaster::Durability::MapSync) {
+      ringmaster::detail::persist(ring.ctrl_, sizeof(Control));
+    } else if (durability == ringmaster::Durability::Msync) {
+      ring.flush();
+    }
+    return ring;
+  }
+
+  /**
+   * @brief Map the existing ring behind `fd` and check its header
+   */
+  static ShmRingMaster reattach(
+      int fd, const std::string &name, ringmaster::Durability durability) {
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+      const int err = errno;
+      ::close(fd);
+      throw std::system_error(err, std::generic_category(), "fstat " + name);
+    }
+    if (static_cast<size_t>(st.st_size) < sizeof(Control)) {
+      ::close(fd);
+      throw std::runtime_error("ShmRingMaster: segment " + name + " is too small");
+    }
+
+    ShmRingMaster ring(fd, static_cast<size_t>(st.st_size), durability);
+    ring.validate();
+    if (durability == ringmaster::Durability::Msync) ring.recover();
+    ring.attach();
+    return ring;
+  }
+
+  /**
+   * @brief Roll head back to the durable head recorded by flush()
+   *
+   * Elements the consumer already released need no replay, so head never
+   * moves below tail.
+   */
+  void recover() noexcept {
+    const size_t durable = ctrl_->durable_head.var.load(std::memory_order_relaxed);
+    const size_t tail    = ctrl_->tail.var.load(std::memory_order_relaxed);
+    const size_t head    = (tail - durable < SIZE_MAX / 2) ? tail : durable;
+    ctrl_->head.var.store(head, std::memory_order_relaxed);
+    ctrl_->durable_head.var.store(head, std::memory_order_relaxed);
+  }
+
+  /** Sync the slots of positions [from, to) */
+  bool syncSlots(size_t from, size_t to, int flags) const noexcept {
+    const size_t n = (to - from < capacity()) ? to - from : capacity();
+    if (n == 0) return true;
+    const size_t idx       = (to - n) & mask_;
+    const size_t first_len = (n > capacity() - idx) ? capacity() - idx : n;
+    return ringmaster::detail::sync_pages(slots_ + idx, first_len * sizeof(Q_TYPE), flags) &&
+           ringmaster::detail::sync_pages(slots_, (n - first_len) * sizeof(Q_TYPE), flags);
+  }
+
+  /** Whether stores must be written back before they are published */
+  bool durable() const noexcept { return durability_ == ringmaster::Durability::MapSync; }
+
+  /** Publish a new head, persisting it in MapSync mode */
+  void publishHead(size_t head) noexcept {
+    ctrl_->head.var.store(head, std::memory_order_release);
+    if (durable()) ringmaster::detail::persist(&ctrl_->head.var, sizeof(size_t));
+  }
+
+  /** Publish a new tail, persisting it in MapSync mode */
+  void publishTail(size_t tail) noexcept {
+    ctrl_->tail.var.store(tail, std::memory_order_release);
+    if (durable()) ringmaster::detail::persist(&ctrl_->tail.var, sizeof(size_t));
+  }
+
+  /** Offset of slot 0, keeping the slots off the control cache lines */
+  static constexpr size_t slotOffset() noexcept {
+    constexpr size_t align = alignof(Q_TYPE) > DESTRUCTIVE_INTERFERENCE_SIZE
+                                 ? alignof(Q_TYPE)
+                                 : DESTRUCTIVE_INTERFERENCE_SIZE;
+    return (sizeof(Control) + align - 1) & ~(align - 1);
+  }
+
+  /** Check an existing header against this build's expectations */
+  void validate() const {
+    const Header &h = ctrl_->header;
+    if (h.ready.load(std::memory_order_acquire) != 1 || h.magic != Header::MAGIC) {
+      throw std::runtime_error("ShmRingMaster: segment is not initialized");
+    }
+    if (h.version != Header::VERSION) {
+      throw std::runtime_error("ShmRingMaster: unsupported layout version");
+    }
+    if (h.cache_line_size != CACHE_LINE_SIZE ||
+        h.interference_size != DESTRUCTIVE_INTERFERENCE_SIZE) {
+      throw std::runtime_error("ShmRingMaster: cache geometry differs from the creator's");
+    }
+    if (h.element_size != sizeof(Q_TYPE) || h.element_align != alignof(Q_TYPE)) {
+      throw std::runtime_error("ShmRingMaster: element type differs from the creator's");
+    }
+    if (h.capacity == 0 || (h.capacity & (h.capacity - 1)) != 0 || h.slot_offset != slotOffset() ||
+        h.slot_offset + h.capacity * sizeof(Q_TYPE) > bytes_) {
+      throw std::runtime_error("ShmRingMaster: corrupt header");
+    }
+  }
+
+  /** Derive the slot pointer and local caches from the header */
+  void attach() noexcept {
+    const Header &h = ctrl_->header;
+    mask_           = h.capacity - 1;
+    slots_          = reinterpret_cast<Q_TYPE *>(reinterpret_cast<char *>(ctrl_) + h.slot_offset);
+    tail_cache_.var = ctrl_->tail.var.load(std::memory_order_acquire);
+    head_cache_.var = ctrl_->head.var.load(std::memory_order_acquire);
+  }
+
+  void unmap() noexcept {
+    if (ctrl_) ::munmap(ctrl_, bytes_);
+    ctrl_ = nullptr;
+  }
+
+  /** Free slots as seen by the producer; reloads tail only when needed */
+  size_t writable(size_t head, size_t want = 1) noexcept {
+    size_t space = capacity() - (head - tail_cache_.var);
+    if (space >= want) return space;
+    tail_cache_.var = ctrl_->tail.var.load(std::memory_order_acquire);
+    return capacity() - (head - tail_cache_.var);
+  }
+
+  /** Filled slots as seen by the consumer; reloads head only when needed */
+  size_t readable(size_t tail, size_t want = 1) noexcept {
+    size_t avail = head_cache_.var - tail;
+    if (avail >= want) return avail;
+    head_cache_.var = ctrl_->head.var.load(std::memory_order_acquire);
+    return head_cache_.var - tail;
+  }
+
+  /**
+   * @brief Park on a process-shared flag unless `ready()` already holds
+   *
+   * Same fence pairing as RingMaster::park(), with a shared futex so the
+   * waker may live in another process.
+   */
+  template<typename READY> static void park(ringmaster::PaddedFlag &flag, READY &&ready) noexcept {
+    flag.var.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!ready() && flag.var.load(std::memory_order_acquire) == 1) {
+      ringmaster::detail::shared_futex_wait(&flag.var, 1);
+    }
+    flag.var.store(0, std::memory_order_relaxed);
+  }
+
+  /** Wake the opposite process if it raised its flag */
+  static void wake(ringmaster::PaddedFlag &flag) noexcept {
+    if constexpr (!WaitStrategy::parks) return;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (flag.var.load(std::memory_order_relaxed) && flag.var.exchange(0, std::memory_order_relaxed)) {
+      ringmaster::detail::shared_futex_wake(&flag.var);
+    }
+  }
+};
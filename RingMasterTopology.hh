@@ -0,0 +1,245 @@
+#pragma once
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "RingMaster.hh"
+
+/**
+ * @brief CPU topology discovery and thread placement helpers
+ *
+ * This header reads the CPU topology from Linux sysfs (the same source
+ * tools/cacheLineSize.cc uses for the cache line size) and offers helpers to
+ * pin the producer and consumer of a ring onto a chosen core pair, or onto
+ * two cores sharing an L2 or L3 cache. Together with the `numa_node`
+ * argument of runtime-sized RingMaster constructors, it keeps a ring's
+ * threads and its slot memory on the same socket.
+ *
+ * @section Usage
+ * @code
+ * auto pair = ringmaster::findSharedCachePair(3);
+ * RingMaster<Order, ringmaster::DynamicCapacity> ring(
+ *     1 << 16, ringmaster::HugePages::None, pair ? pair->numa_node : ringmaster::AnyNumaNode);
+ *
+ * std::thread producer([&] { ringmaster::pinCurrentThread(pair->producer); ... });
+ * std::thread consumer([&] { ringmaster::pinCurrentThread(pair->consumer); ... });
+ * @endcode
+ *
+ * On other platforms discovery returns no CPUs and pinning reports failure.
+ */
+
+namespace ringmaster {
+
+/**
+ * @struct CpuInfo
+ * @brief Placement of one online logical CPU
+ *
+ * Cache ids identify the group of CPUs sharing that cache (the lowest CPU
+ * number in its shared_cpu_list); -1 means the level was not reported.
+ */
+struct CpuInfo {
+  int cpu       = -1; /**< Logical CPU number */
+  int core      = -1; /**< Physical core id within the package */
+  int package   = -1; /**< Socket (physical package) id */
+  int numa_node = -1; /**< NUMA node the CPU belongs to */
+  int l2        = -1; /**< Id of the L2 cache shared by this CPU */
+  int l3        = -1; /**< Id of the L3 cache shared by this CPU */
+};
+
+/**
+ * @struct CorePair
+ * @brief Producer and consumer CPUs chosen for one ring
+ */
+struct CorePair {
+  int producer  = -1;          /**< CPU for the producer thread */
+  int consumer  = -1;          /**< CPU for the consumer thread */
+  int numa_node = AnyNumaNode; /**< Node both CPUs belong to */
+};
+
+namespace detail {
+
+/**
+ * @brief Parse a sysfs CPU list such as "0-3,8,10-11"
+ */
+inline std::vector<int> parse_cpu_list(const std::string &list) {
+  std::vector<int> cpus;
+  size_t           pos = 0;
+  while (pos < list.size()) {
+    size_t     end   = list.find(',', pos);
+    const auto range = list.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+    const auto dash  = range.find('-');
+    try {
+      const int first = std::stoi(range.substr(0, dash));
+      const int last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int c = first; c <= last; ++c) cpus.push_back(c);
+    } catch (const std::exception &) {
+      // Ignore malformed entries (e.g. a trailing newline)
+    }
+    if (end == std::string::npos) break;
+    pos = end + 1;
+  }
+  return cpus;
+}
+
+#if defined(__linux__)
+/** Read the first line of a sysfs file; empty if it does not exist */
+inline std::string read_sysfs(const std::string &path) {
+  std::ifstream f(path);
+  std::string   line;
+  std::getline(f, line);
+  return line;
+}
+
+/** Read an integer from a sysfs file, or `fallback` */
+inline int read_sysfs_int(const std::string &path, int fallback = -1) {
+  std::ifstream f(path);
+  int           v = fallback;
+  if (f >> v) return v;
+  return fallback;
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Enumerate the online CPUs with their core, socket, node and caches
+ *
+ * @return One entry per online CPU in ascending CPU order; empty if the
+ * topology is not available
+ */
+inline std::vector<CpuInfo> discoverTopology() {
+  std::vector<CpuInfo> cpus;
+#if defined(__linux__)
+  const std::string root = "/sys/devices/system/cpu/";
+  for (int cpu : detail::parse_cpu_list(detail::read_sysfs(root + "online"))) {
+    const std::string dir = root + "cpu" + std::to_string(cpu) + "/";
+    CpuInfo           info;
+    info.cpu     = cpu;
+    info.core    = detail::read_sysfs_int(dir + "topology/core_id");
+    info.package = detail::read_sysfs_int(dir + "topology/physical_package_id");
+
+    for (int index = 0;; ++index) {
+      const std::string cache = dir + "cache/index" + std::to_string(index) + "/";
+      const int         level = detail::read_sysfs_int(cache + "level");
+      if (level < 0) break;
+      if (detail::read_sysfs(cache + "type") == "Instruction") continue;
+      const std::vector<int> shared =
+          detail::parse_cpu_list(detail::read_sysfs(cache + "shared_cpu_list"));
+      const int id = shared.empty() ? cpu : shared.front();
+      if (level == 2) info.l2 = id;
+      if (level == 3) info.l3 = id;
+    }
+    cpus.push_back(info);
+  }
+
+  // CPUs are listed per node. Node numbers may be sparse and memory-only
+  // nodes list no CPUs, so walk the online list; a kernel without NUMA has
+  // no node directory at all.
+  const std::string nodes  = "/sys/devices/system/node/";
+  const std::string online = detail::read_sysfs(nodes + "online");
+  if (online.empty()) {
+    for (CpuInfo &c : cpus) c.numa_node = 0;
+  }
+  for (int node : detail::parse_cpu_list(online)) {
+    const std::string list =
+        detail::read_sysfs(nodes + "node" + std::to_string(node) + "/cpulist");
+    for (int cpu : detail::parse_cpu_list(list)) {
+      for (CpuInfo &c : cpus) {
+        if (c.cpu == cpu) c.numa_node = node;
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+/**
+ * @brief Pin the calling thread to logical CPU `cpu`
+ *
+ * @return true on success, false if `cpu` is negative or the call failed
+ */
+inline bool pinCurrentThread(int cpu) noexcept {
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+/**
+ * @brief Pin an already running std::thread to logical CPU `cpu`
+ *
+ * @return true on success, false if `cpu` is negative or the call failed
+ */
+inline bool pinThread(std::thread &thread, int cpu) noexcept {
+#if defined(__linux__)
+  if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+#else
+  (void)thread;
+  (void)cpu;
+  return false;
+#endif
+}
+
+/**
+ * @brief NUMA node of logical CPU `cpu`, or AnyNumaNode if unknown
+ */
+inline int numaNodeOf(int cpu) {
+  for (const CpuInfo &c : discoverTopology()) {
+    if (c.cpu == cpu) return c.numa_node < 0 ? AnyNumaNode : c.numa_node;
+  }
+  return AnyNumaNode;
+}
+
+/**
+ * @brief Pick two CPUs sharing a cache of the given level
+ *
+ * Prefers two different physical cores, so the pair does not compete for
+ * one core's execution units; SMT siblings are used only when no such pair
+ * shares the cache (typically for a per-core L2).
+ *
+ * @param level Cache level the pair must share (2 or 3)
+ * @param numa_node Restrict the search to this node, or AnyNumaNode
+ * @return The pair, or std::nullopt if no two CPUs share such a cache
+ */
+inline std::optional<CorePair> findSharedCachePair(int level = 3, int numa_node = AnyNumaNode) {
+  const std::vector<CpuInfo> cpus = discoverTopology();
+  std::optional<CorePair>    siblings;
+
+  for (size_t i = 0; i < cpus.size(); ++i) {
+    const CpuInfo &a  = cpus[i];
+    const int      ca = (level == 2) ? a.l2 : a.l3;
+    if (ca < 0 || (numa_node != AnyNumaNode && a.numa_node != numa_node)) continue;
+
+    for (size_t j = i + 1; j < cpus.size(); ++j) {
+      const CpuInfo &b  = cpus[j];
+      const int      cb = (level == 2) ? b.l2 : b.l3;
+      if (cb != ca || b.numa_node != a.numa_node) continue;
+
+      const CorePair pair{a.cpu, b.cpu, a.numa_node < 0 ? AnyNumaNode : a.numa_node};
+      if (a.core != b.core || a.package != b.package) return pair;
+      if (!siblings) siblings = pair;
+    }
+  }
+  return siblings;
+}
+
+} // namespace ringmaster
@@ -0,0 +1,436 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RingMaster.hh"
+#include "RingMasterTopology.hh"
+
+/**
+ * @brief Round-trip latency benchmark and core-to-core latency matrix
+ *
+ * Two threads bounce one element back and forth through a pair of
+ * RingMaster instances: the initiator pushes into `ping` and waits on
+ * `pong`, the echo thread pops from `ping` and pushes the element back.
+ * Every round trip is timed individually, so the percentiles describe a
+ * single push -> pop -> push -> pop cycle with no queueing, unlike the
+ * sampled push-to-pop latency of ringmaster_bench, which includes the time
+ * elements spend behind each other in a busy ring.
+ *
+ * Usage:
+ *   pingpong_bench [--rounds N] [--warmup N] [--sizes 8,64,...]
+ *                  [--strategies spin,hybrid,...] [--pin A,B]
+ *                  [--matrix [--cpus 0,1,...]] [--output FILE]
+ *
+ * Sweep mode (the default) measures every element size and wait strategy
+ * on one CPU pair. `--matrix` instead measures every pair of the online
+ * CPUs (or of `--cpus`) with the first size and strategy, and reports the
+ * median and p99 RTT as matrices to guide thread placement. Results are
+ * JSON, with the same host metadata as ringmaster_bench.
+ */
+
+namespace {
+
+/**
+ * @struct Payload
+ * @brief Element of exactly N bytes whose leading bytes carry a sequence number
+ */
+template<size_t N> struct Payload {
+  unsigned char bytes[N];
+
+  Payload() noexcept = default;
+  explicit Payload(uint64_t seq) noexcept {
+    std::memset(bytes, 0, N);
+    std::memcpy(bytes, &seq, N < sizeof(seq) ? N : sizeof(seq));
+  }
+
+  uint64_t seq() const noexcept {
+    uint64_t v = 0;
+    std::memcpy(&v, bytes, N < sizeof(v) ? N : sizeof(v));
+    return v;
+  }
+};
+
+struct Config {
+  size_t                   rounds = 100'000;
+  size_t                   warmup = 10'000;
+  std::vector<size_t>      sizes{8, 64, 256, 1024};
+  std::vector<std::string> strategies{"spin", "hybrid"};
+  int                      cpu_a  = -1;
+  int                      cpu_b  = -1;
+  bool                     matrix = false;
+  std::vector<size_t>      cpus;
+  std::string              output;
+};
+
+struct Result {
+  std::string strategy;
+  size_t      element_size;
+  int         cpu_a, cpu_b;
+  double      min_ns, p50_ns, p90_ns, p99_ns, p999_ns, max_ns, mean_ns;
+  bool        valid;
+};
+
+uint64_t now_ns() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double percentile(const std::vector<uint64_t> &sorted, double p) noexcept {
+  if (sorted.empty()) return 0.0;
+  const size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+  return static_cast<double>(sorted[idx]);
+}
+
+/**
+ * @brief Time `warmup + rounds` round trips between CPUs `a` and `b`
+ */
+template<size_t N, typename STRATEGY> Result run_one(const Config &cfg, int a, int b) {
+  using Elem = Payload<N>;
+  using Ring = RingMaster<Elem, 64, true, STRATEGY>;
+
+  const size_t total = cfg.warmup + cfg.rounds;
+  auto         ping  = std::make_unique<Ring>();
+  auto         pong  = std::make_unique<Ring>();
+
+  std::vector<uint64_t> rtts;
+  rtts.reserve(cfg.rounds);
+  bool valid = true;
+
+  std::thread echo([&] {
+    ringmaster::pinCurrentThread(b);
+    Elem e;
+    for (size_t i = 0; i < total; ++i) {
+      ping->pop_wait(e);
+      pong->push_wait(e);
+    }
+  });
+
+  std::thread initiator([&] {
+    ringmaster::pinCurrentThread(a);
+    const uint64_t seq_mask = N >= sizeof(uint64_t) ? ~uint64_t(0) : (uint64_t(1) << (8 * N)) - 1;
+    Elem           back;
+    for (size_t i = 0; i < total; ++i) {
+      const uint64_t start = now_ns();
+      ping->push_wait(Elem(i));
+      pong->pop_wait(back);
+      const uint64_t rtt = now_ns() - start;
+      if (back.seq() != (i & seq_mask)) valid = false;
+      if (i >= cfg.warmup) rtts.push_back(rtt);
+    }
+  });
+
+  initiator.join();
+  echo.join();
+
+  uint64_t sum = 0;
+  for (uint64_t v : rtts) sum += v;
+  std::sort(rtts.begin(), rtts.end());
+
+  Result r{};
+  r.element_size = N;
+  r.cpu_a        = a;
+  r.cpu_b        = b;
+  r.min_ns       = rtts.empty() ? 0.0 : static_cast<double>(rtts.front());
+  r.p50_ns       = percentile(rtts, 0.50);
+  r.p90_ns       = percentile(rtts, 0.90);
+  r.p99_ns       = percentile(rtts, 0.99);
+  r.p999_ns      = percentile(rtts, 0.999);
+  r.max_ns       = rtts.empty() ? 0.0 : static_cast<double>(rtts.back());
+  r.mean_ns      = rtts.empty() ? 0.0 : static_cast<double>(sum) / rtts.size();
+  r.valid        = valid;
+  return r;
+}
+
+template<size_t N>
+bool run_strategy(const Config &cfg, const std::string &strategy, int a, int b, Result &r) {
+  if (strategy == "hybrid") {
+    r = run_one<N, ringmaster::HybridWait<>>(cfg, a, b);
+  } else if (strategy == "spin") {
+    r = run_one<N, ringmaster::BusySpinWait>(cfg, a, b);
+  } else if (strategy == "backoff") {
+    r = run_one<N, ringmaster::BackoffWait<>>(cfg, a, b);
+  } else if (strategy == "yield") {
+    r = run_one<N, ringmaster::YieldWait>(cfg, a, b);
+  } else if (strategy == "block") {
+    r = run_one<N, ringmaster::BlockWait>(cfg, a, b);
+  } else {
+    return false;
+  }
+  r.strategy = strategy;
+  return true;
+}
+
+/** Element sizes compiled into the benchmark */
+bool dispatch(
+    const Config &cfg, size_t size, const std::string &strategy, int a, int b, Result &r) {
+  switch (size) {
+    case 8: return run_strategy<8>(cfg, strategy, a, b, r);
+    case 16: return run_strategy<16>(cfg, strategy, a, b, r);
+    case 32: return run_strategy<32>(cfg, strategy, a, b, r);
+    case 64: return run_strategy<64>(cfg, strategy, a, b, r);
+    case 128: return run_strategy<128>(cfg, strategy, a, b, r);
+    case 256: return run_strategy<256>(cfg, strategy, a, b, r);
+    case 512: return run_strategy<512>(cfg, strategy, a, b, r);
+    case 1024: return run_strategy<1024>(cfg, strategy, a, b, r);
+    case 4096: return run_strategy<4096>(cfg, strategy, a, b, r);
+    default: return false;
+  }
+}
+
+std::vector<std::string> split(const std::string &s) {
+  std::vector<std::string> out;
+  size_t                   start = 0;
+  while (start <= s.size()) {
+    const size_t end = s.find(',', start);
+    if (end == std::string::npos) {
+      if (start < s.size()) out.push_back(s.substr(start));
+      break;
+    }
+    if (end > start) out.push_back(s.substr(start, end - start));
+    start = end + 1;
+  }
+  return out;
+}
+
+std::vector<size_t> split_numbers(const std::string &s) {
+  std::vector<size_t> out;
+  for (const auto &v : split(s)) out.push_back(std::strtoull(v.c_str(), nullptr, 10));
+  return out;
+}
+
+void usage(const char *argv0) {
+  std::fprintf(stderr,
+      "usage: %s [--rounds N] [--warmup N] [--sizes 8,64,...]\n"
+      "          [--strategies spin,hybrid,backoff,yield,block] [--pin A,B]\n"
+      "          [--matrix] [--cpus 0,1,...] [--output FILE]\n"
+      "element sizes: 8 16 32 64 128 256 512 1024 4096\n",
+      argv0);
+}
+
+bool parse(int argc, char **argv, Config &cfg) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--matrix") {
+      cfg.matrix = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    const std::string val = argv[++i];
+
+    if (arg == "--rounds") {
+      cfg.rounds = std::strtoull(val.c_str(), nullptr, 10);
+    } else if (arg == "--warmup") {
+      cfg.warmup = std::strtoull(val.c_str(), nullptr, 10);
+    } else if (arg == "--sizes") {
+      cfg.sizes = split_numbers(val);
+    } else if (arg == "--strategies") {
+      cfg.strategies = split(val);
+    } else if (arg == "--pin") {
+      const auto cpus = split_numbers(val);
+      if (cpus.size() != 2) return false;
+      cfg.cpu_a = static_cast<int>(cpus[0]);
+      cfg.cpu_b = static_cast<int>(cpus[1]);
+    } else if (arg == "--cpus") {
+      cfg.cpus = split_numbers(val);
+    } else if (arg == "--output") {
+      cfg.output = val;
+    } else {
+      return false;
+    }
+  }
+  return cfg.rounds > 0 && !cfg.sizes.empty() && !cfg.strategies.empty();
+}
+
+void write_header(std::FILE *f, const Config &cfg) {
+  std::fprintf(f, "{\n");
+  std::fprintf(f, "  \"benchmark\": \"pingpong_bench\",\n");
+  std::fprintf(f, "  \"cache_line_size\": %d,\n", CACHE_LINE_SIZE);
+  std::fprintf(f, "  \"interference_size\": %d,\n", DESTRUCTIVE_INTERFERENCE_SIZE);
+  std::fprintf(f, "  \"l1d_cache_size\": %d,\n", L1D_CACHE_SIZE);
+  std::fprintf(f, "  \"l2_cache_size\": %d,\n", L2_CACHE_SIZE);
+  std::fprintf(f, "  \"smt_width\": %d,\n", SMT_WIDTH);
+  std::fprintf(f, "  \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+  std::fprintf(f, "  \"rounds\": %zu,\n", cfg.rounds);
+  std::fprintf(f, "  \"warmup\": %zu,\n", cfg.warmup);
+}
+
+void write_results(std::FILE *f, const std::vector<Result> &results) {
+  std::fprintf(f, "  \"results\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto &r = results[i];
+    std::fprintf(f,
+        "    {\"strategy\": \"%s\", \"element_size\": %zu, \"cpu_a\": %d, \"cpu_b\": %d, "
+        "\"rtt_ns\": {\"min\": %.0f, \"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, "
+        "\"p999\": %.0f, \"max\": %.0f, \"mean\": %.1f}, \"valid\": %s}%s\n",
+        r.strategy.c_str(),
+        r.element_size,
+        r.cpu_a,
+        r.cpu_b,
+        r.min_ns,
+        r.p50_ns,
+        r.p90_ns,
+        r.p99_ns,
+        r.p999_ns,
+        r.max_ns,
+        r.mean_ns,
+        r.valid ? "true" : "false",
+        i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(f, "  ]");
+}
+
+/** One row per CPU of `cpus`; `cell(i, j)` for i != j, null on the diagonal */
+template<typename CELL>
+void write_matrix(std::FILE *f, const char *name, size_t n, CELL &&cell, bool last) {
+  std::fprintf(f, "    \"%s\": [\n", name);
+  for (size_t i = 0; i < n; ++i) {
+    std::fprintf(f, "      [");
+    for (size_t j = 0; j < n; ++j) {
+      if (i == j) {
+        std::fprintf(f, "null");
+      } else {
+        std::fprintf(f, "%.0f", cell(i, j));
+      }
+      std::fprintf(f, "%s", j + 1 < n ? ", " : "");
+    }
+    std::fprintf(f, "]%s\n", i + 1 < n ? "," : "");
+  }
+  std::fprintf(f, "    ]%s\n", last ? "" : ",");
+}
+
+/**
+ * @brief Sweep mode: every size and strategy on one CPU pair
+ */
+bool run_sweep(const Config &cfg, std::FILE *out) {
+  std::vector<Result> results;
+  for (const auto &strategy : cfg.strategies) {
+    for (size_t size : cfg.sizes) {
+      Result r;
+      if (!dispatch(cfg, size, strategy, cfg.cpu_a, cfg.cpu_b, r)) {
+        std::fprintf(stderr,
+            "skipping unsupported combination: size=%zu strategy=%s\n",
+            size,
+            strategy.c_str());
+        continue;
+      }
+      std::fprintf(stderr,
+          "%-7s %5zu B: rtt p50 %8.0f ns  p99 %8.0f ns  max %10.0f ns\n",
+          r.strategy.c_str(),
+          r.element_size,
+          r.p50_ns,
+          r.p99_ns,
+          r.max_ns);
+      results.push_back(std::move(r));
+    }
+  }
+
+  write_header(out, cfg);
+  std::fprintf(out, "  \"cpu_a\": %d,\n", cfg.cpu_a);
+  std::fprintf(out, "  \"cpu_b\": %d,\n", cfg.cpu_b);
+  write_results(out, results);
+  std::fprintf(out, "\n}\n");
+  return std::all_of(results.begin(), results.end(), [](const Result &r) { return r.valid; });
+}
+
+/**
+ * @brief Matrix mode: every CPU pair with the first size and strategy
+ *
+ * RTT is symmetric, so each unordered pair is measured once and mirrored.
+ */
+bool run_matrix(const Config &cfg, std::FILE *out) {
+  std::vector<ringmaster::CpuInfo> cpus;
+  for (const auto &info : ringmaster::discoverTopology()) {
+    if (cfg.cpus.empty() ||
+        std::find(cfg.cpus.begin(), cfg.cpus.end(), static_cast<size_t>(info.cpu)) !=
+            cfg.cpus.end()) {
+      cpus.push_back(info);
+    }
+  }
+  const size_t n = cpus.size();
+  if (n < 2) {
+    std::fprintf(stderr, "--matrix needs at least two online CPUs\n");
+    return false;
+  }
+
+  const std::string  &strategy = cfg.strategies.front();
+  const size_t        size     = cfg.sizes.front();
+  std::vector<Result> cells(n * n);
+  bool                valid = true;
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = i + 1; j < n; ++j) {
+      Result r;
+      if (!dispatch(cfg, size, strategy, cpus[i].cpu, cpus[j].cpu, r)) {
+        std::fprintf(stderr,
+            "unsupported combination: size=%zu strategy=%s\n",
+            size,
+            strategy.c_str());
+        return false;
+      }
+      std::fprintf(stderr,
+          "cpu %3d <-> %3d: rtt p50 %8.0f ns  p99 %8.0f ns\n",
+          cpus[i].cpu,
+          cpus[j].cpu,
+          r.p50_ns,
+          r.p99_ns);
+      valid            = valid && r.valid;
+      cells[i * n + j] = r;
+      cells[j * n + i] = r;
+    }
+  }
+
+  write_header(out, cfg);
+  std::fprintf(out, "  \"strategy\": \"%s\",\n", strategy.c_str());
+  std::fprintf(out, "  \"element_size\": %zu,\n", size);
+  std::fprintf(out, "  \"matrix\": {\n");
+  std::fprintf(out, "    \"cpus\": [\n");
+  for (size_t i = 0; i < n; ++i) {
+    std::fprintf(out,
+        "      {\"cpu\": %d, \"core\": %d, \"package\": %d, \"numa_node\": %d, \"l2\": %d, "
+        "\"l3\": %d}%s\n",
+        cpus[i].cpu,
+        cpus[i].core,
+        cpus[i].package,
+        cpus[i].numa_node,
+        cpus[i].l2,
+        cpus[i].l3,
+        i + 1 < n ? "," : "");
+  }
+  std::fprintf(out, "    ],\n");
+  const auto p50 = [&](size_t i, size_t j) { return cells[i * n + j].p50_ns; };
+  const auto p99 = [&](size_t i, size_t j) { return cells[i * n + j].p99_ns; };
+  write_matrix(out, "p50_ns", n, p50, false);
+  write_matrix(out, "p99_ns", n, p99, true);
+  std::fprintf(out, "  }\n}\n");
+  return valid;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Config cfg;
+  if (!parse(argc, argv, cfg)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::FILE *out = stdout;
+  if (!cfg.output.empty()) {
+    out = std::fopen(cfg.output.c_str(), "w");
+    if (!out) {
+      std::perror(cfg.output.c_str());
+      return 1;
+    }
+  }
+  const bool ok = cfg.matrix ? run_matrix(cfg, out) : run_sweep(cfg, out);
+  if (out != stdout) std::fclose(out);
+  return ok ? 0 : 1;
+}
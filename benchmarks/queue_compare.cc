@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "RingMaster.hh"
+
+/**
+ * @brief Compare the SPSC, MPSC and MPMC rings on the benchmark element sizes
+ *
+ * Every queue moves the same number of items through push_wait()/pop_wait()
+ * with the default wait strategy and a capacity of 512, matching the setup
+ * behind benchmarks/README.md. The SPSC row is the RingMaster fast path;
+ * the MPSC/MPMC rows split the items across the requested thread counts.
+ *
+ * Usage: queue_compare [items] [producers] [consumers]
+ */
+
+static constexpr size_t CAPACITY = 512;
+
+/**
+ * @struct Payload
+ * @brief Element of exactly N bytes whose leading bytes carry a sequence number
+ */
+template<size_t N> struct Payload {
+  unsigned char bytes[N];
+
+  Payload() noexcept = default;
+  explicit Payload(uint64_t seq) noexcept {
+    std::memset(bytes, 0, N);
+    std::memcpy(bytes, &seq, N < sizeof(seq) ? N : sizeof(seq));
+  }
+
+  uint64_t seq() const noexcept {
+    uint64_t v = 0;
+    std::memcpy(&v, bytes, N < sizeof(v) ? N : sizeof(v));
+    return v;
+  }
+};
+
+struct Result {
+  double seconds;
+  bool   ok;
+};
+
+/**
+ * @brief Run `producers` pushing threads and `consumers` popping threads
+ *
+ * With one producer and one consumer the consumer also checks that sequence
+ * numbers arrive in increasing order; in every configuration the consumers
+ * together verify the total count.
+ */
+template<typename ELEM, typename QUEUE>
+static Result run(QUEUE &queue, size_t items, unsigned producers, unsigned consumers) {
+  std::vector<std::thread> threads;
+  std::atomic<size_t>      received{0};
+  std::atomic<bool>        ok{true};
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (size_t i = p; i < items; i += producers) queue.push_wait(ELEM(i));
+    });
+  }
+  for (unsigned c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      const size_t mine = items / consumers + (c < items % consumers ? 1 : 0);
+      ELEM         out{};
+      uint64_t     last = 0;
+      for (size_t k = 0; k < mine; ++k) {
+        queue.pop_wait(out);
+        if (producers == 1 && consumers == 1 && k && out.seq() <= last) {
+          ok.store(false, std::memory_order_relaxed);
+        }
+        last = out.seq();
+      }
+      received.fetch_add(mine, std::memory_order_relaxed);
+    });
+  }
+  for (auto &t : threads) t.join();
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return {elapsed.count(), ok.load() && received.load() == items};
+}
+
+static void report(const char *queue,
+    size_t                   elem,
+    unsigned                 producers,
+    unsigned                 consumers,
+    size_t                   items,
+    const Result            &r) {
+  const double rate = items / r.seconds;
+  std::printf("| %6zu B | %-5s | %2u | %2u | %14.0f | %12.2f | %s |\n",
+      elem,
+      queue,
+      producers,
+      consumers,
+      rate,
+      rate * elem / (1024.0 * 1024.0),
+      r.ok ? "yes" : "NO");
+}
+
+template<size_t N> static void compare(size_t items, unsigned producers, unsigned consumers) {
+  using Elem = Payload<N>;
+  {
+    auto q = std::make_unique<RingMaster<Elem, CAPACITY, true>>();
+    report("SPSC", N, 1, 1, items, run<Elem>(*q, items, 1, 1));
+  }
+  {
+    auto q = std::make_unique<MPSCRingMaster<Elem, CAPACITY>>();
+    report("MPSC", N, 1, 1, items, run<Elem>(*q, items, 1, 1));
+    report("MPSC", N, producers, 1, items, run<Elem>(*q, items, producers, 1));
+  }
+  {
+    auto q = std::make_unique<MPMCRingMaster<Elem, CAPACITY>>();
+    report("MPMC", N, 1, 1, items, run<Elem>(*q, items, 1, 1));
+    report("MPMC", N, producers, consumers, items, run<Elem>(*q, items, producers, consumers));
+  }
+}
+
+int main(int argc, char **argv) {
+  const size_t   items     = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  const unsigned producers = argc > 2 ? std::atoi(argv[2]) : 2;
+  const unsigned consumers = argc > 3 ? std::atoi(argv[3]) : 2;
+
+  std::printf("| Element | Queue | P | C | Throughput (items/s) | Bandwidth (MB/s) | Valid |\n");
+  std::printf("|--------:|:------|--:|--:|---------------------:|-----------------:|:-----:|\n");
+
+  compare<4>(items, producers, consumers);
+  compare<8>(items, producers, consumers);
+  compare<16>(items, producers, consumers);
+  compare<32>(items, producers, consumers);
+  compare<64>(items, producers, consumers);
+  compare<1024>(items, producers, consumers);
+  compare<2048>(items, producers, consumers);
+  compare<4096>(items, producers, consumers);
+  return 0;
+}
@@ -0,0 +1,476 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RingMaster.hh"
+#include "RingMasterTopology.hh"
+
+/**
+ * @brief Reproducible throughput/latency benchmark for RingMaster
+ *
+ * Sweeps element size, ring capacity, wait strategy and index mode, moving
+ * `--items` elements from one producer to one consumer through
+ * push_wait()/pop_wait() for every combination. Each run reports
+ * throughput, bandwidth, spin/block percentages (as in benchmarks/README.md)
+ * and push-to-pop latency percentiles taken from a sample of the elements.
+ * Results are written as JSON (default) or CSV so they can be tracked
+ * across releases.
+ *
+ * Usage:
+ *   ringmaster_bench [--items N] [--repeat R] [--sizes 4,8,...]
+ *                    [--capacities 512,4096,...] [--strategies hybrid,spin,...]
+ *                    [--index shared,cached] [--layouts dense,prefetch,...]
+ *                    [--pin PRODUCER,CONSUMER|auto] [--format json|csv] [--output FILE]
+ *
+ * `--pin auto` picks two cores sharing an L3 cache and places the ring's
+ * slots on their NUMA node. `--layouts` selects slot layouts: dense (the
+ * default), prefetch (dense with an 8-slot consumer prefetch), padded (one
+ * line per slot) and swizzled (neighbouring indices on different lines,
+ * 8-slot prefetch); the last three apply to elements up to a cache line.
+ */
+
+namespace {
+
+/** Every LATENCY_SAMPLE-th element carries a latency timestamp */
+constexpr size_t LATENCY_SAMPLE = 64;
+
+/**
+ * @struct Payload
+ * @brief Element of exactly N bytes whose leading bytes carry a sequence number
+ */
+template<size_t N> struct Payload {
+  unsigned char bytes[N];
+
+  Payload() noexcept = default;
+  explicit Payload(uint64_t seq) noexcept {
+    std::memset(bytes, 0, N);
+    std::memcpy(bytes, &seq, N < sizeof(seq) ? N : sizeof(seq));
+  }
+
+  uint64_t seq() const noexcept {
+    uint64_t v = 0;
+    std::memcpy(&v, bytes, N < sizeof(v) ? N : sizeof(v));
+    return v;
+  }
+};
+
+struct Config {
+  size_t                   items = 10'000'000;
+  size_t                   repeat = 1;
+  std::vector<size_t>      sizes{4, 8, 16, 32, 64, 1024, 2048, 4096};
+  std::vector<size_t>      capacities{512};
+  std::vector<std::string> strategies{"hybrid"};
+  std::vector<std::string> indices{"shared", "cached"};
+  std::vector<std::string> layouts{"dense"};
+  int                      producer_cpu = -1;
+  int                      consumer_cpu = -1;
+  int                      numa_node    = ringmaster::AnyNumaNode;
+  bool                     csv          = false;
+  std::string              output;
+};
+
+struct Result {
+  std::string strategy;
+  std::string index;
+  std::string layout;
+  size_t      element_size;
+  size_t      capacity;
+  size_t      run;
+  double      seconds;
+  double      items_per_sec;
+  double      mb_per_sec;
+  double      push_spin_pct;
+  double      pop_spin_pct;
+  double      push_block_pct;
+  double      pop_block_pct;
+  double      p50_ns, p90_ns, p99_ns, p999_ns, max_ns;
+  bool        valid;
+};
+
+uint64_t now_ns() noexcept {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+double percentile(const std::vector<uint64_t> &sorted, double p) noexcept {
+  if (sorted.empty()) return 0.0;
+  const size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+  return static_cast<double>(sorted[idx]);
+}
+
+/**
+ * @brief One producer/consumer run on a freshly allocated ring
+ */
+template<size_t N, bool CACHED, typename STRATEGY, typename LAYOUT>
+Result run_one(const Config &cfg, size_t capacity, size_t run) {
+  using Elem = Payload<N>;
+  using Ring = RingMaster<Elem,
+      ringmaster::DynamicCapacity,
+      CACHED,
+      STRATEGY,
+      ringmaster::CountingStats,
+      LAYOUT>;
+
+  const size_t items = cfg.items;
+  auto ring = std::make_unique<Ring>(capacity, ringmaster::HugePages::None, cfg.numa_node);
+
+  std::vector<uint64_t> stamps(items / LATENCY_SAMPLE + 1);
+  std::vector<uint64_t> latencies;
+  latencies.reserve(stamps.size());
+
+  std::atomic<bool> go{false};
+  bool              valid = true;
+
+  std::thread producer([&] {
+    ringmaster::pinCurrentThread(cfg.producer_cpu);
+    while (!go.load(std::memory_order_acquire)) ringmaster::cpu_relax();
+    for (size_t i = 0; i < items; ++i) {
+      if (i % LATENCY_SAMPLE == 0) stamps[i / LATENCY_SAMPLE] = now_ns();
+      ring->push_wait(Elem(i));
+    }
+  });
+
+  std::thread consumer([&] {
+    ringmaster::pinCurrentThread(cfg.consumer_cpu);
+    while (!go.load(std::memory_order_acquire)) ringmaster::cpu_relax();
+    Elem           out{};
+    const uint64_t seq_mask = N >= sizeof(uint64_t) ? ~uint64_t(0) : (uint64_t(1) << (8 * N)) - 1;
+    for (size_t i = 0; i < items; ++i) {
+      ring->pop_wait(out);
+      if (out.seq() != (i & seq_mask)) valid = false;
+      if (i % LATENCY_SAMPLE == 0) latencies.push_back(now_ns() - stamps[i / LATENCY_SAMPLE]);
+    }
+  });
+
+  const auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  producer.join();
+  consumer.join();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::sort(latencies.begin(), latencies.end());
+  const ringmaster::StatsSnapshot stats = ring->stats().snapshot();
+
+  Result r{};
+  r.index          = CACHED ? "cached" : "shared";
+  r.element_size   = N;
+  r.capacity       = capacity;
+  r.run            = run;
+  r.seconds        = elapsed.count();
+  r.items_per_sec  = items / r.seconds;
+  r.mb_per_sec     = r.items_per_sec * N / (1024.0 * 1024.0);
+  r.push_spin_pct  = 100.0 * stats.producer_spins / items;
+  r.pop_spin_pct   = 100.0 * stats.consumer_spins / items;
+  r.push_block_pct = 100.0 * stats.producer_parks / items;
+  r.pop_block_pct  = 100.0 * stats.consumer_parks / items;
+  r.p50_ns         = percentile(latencies, 0.50);
+  r.p90_ns         = percentile(latencies, 0.90);
+  r.p99_ns         = percentile(latencies, 0.99);
+  r.p999_ns        = percentile(latencies, 0.999);
+  r.max_ns         = latencies.empty() ? 0.0 : static_cast<double>(latencies.back());
+  r.valid          = valid;
+  return r;
+}
+
+/**
+ * @struct Run
+ * @brief One point of the sweep, identified by name on every axis
+ */
+struct Run {
+  std::string strategy;
+  std::string index;
+  std::string layout;
+  size_t      capacity;
+  size_t      run;
+};
+
+template<size_t N, bool CACHED, typename LAYOUT>
+bool run_strategy(const Config &cfg, const Run &p, Result &r) {
+  if (p.strategy == "hybrid") {
+    r = run_one<N, CACHED, ringmaster::HybridWait<>, LAYOUT>(cfg, p.capacity, p.run);
+  } else if (p.strategy == "spin") {
+    r = run_one<N, CACHED, ringmaster::BusySpinWait, LAYOUT>(cfg, p.capacity, p.run);
+  } else if (p.strategy == "backoff") {
+    r = run_one<N, CACHED, ringmaster::BackoffWait<>, LAYOUT>(cfg, p.capacity, p.run);
+  } else if (p.strategy == "yield") {
+    r = run_one<N, CACHED, ringmaster::YieldWait, LAYOUT>(cfg, p.capacity, p.run);
+  } else if (p.strategy == "block") {
+    r = run_one<N, CACHED, ringmaster::BlockWait, LAYOUT>(cfg, p.capacity, p.run);
+  } else {
+    return false;
+  }
+  r.strategy = p.strategy;
+  r.layout   = p.layout;
+  return true;
+}
+
+template<size_t N, bool CACHED> bool run_layout(const Config &cfg, const Run &p, Result &r) {
+  if (p.layout == "dense") return run_strategy<N, CACHED, ringmaster::DenseLayout<>>(cfg, p, r);
+
+  // The other layouts only change anything for elements up to a cache line
+  if constexpr (N <= CACHE_LINE_SIZE && CACHE_LINE_SIZE % N == 0) {
+    using Prefetch = ringmaster::DenseLayout<8>;
+    using Padded   = ringmaster::PaddedLayout<>;
+    using Swizzled = ringmaster::SwizzledLayout<8>;
+    if (p.layout == "prefetch") return run_strategy<N, CACHED, Prefetch>(cfg, p, r);
+    if (p.layout == "padded") return run_strategy<N, CACHED, Padded>(cfg, p, r);
+    if (p.layout == "swizzled") return run_strategy<N, CACHED, Swizzled>(cfg, p, r);
+  }
+  return false;
+}
+
+template<size_t N> bool run_size(const Config &cfg, const Run &p, Result &r) {
+  if (p.index == "cached") return run_layout<N, true>(cfg, p, r);
+  if (p.index == "shared") return run_layout<N, false>(cfg, p, r);
+  return false;
+}
+
+/** Element sizes compiled into the benchmark */
+bool dispatch(const Config &cfg, size_t size, const Run &p, Result &r) {
+  switch (size) {
+    case 4: return run_size<4>(cfg, p, r);
+    case 8: return run_size<8>(cfg, p, r);
+    case 16: return run_size<16>(cfg, p, r);
+    case 32: return run_size<32>(cfg, p, r);
+    case 64: return run_size<64>(cfg, p, r);
+    case 128: return run_size<128>(cfg, p, r);
+    case 256: return run_size<256>(cfg, p, r);
+    case 512: return run_size<512>(cfg, p, r);
+    case 1024: return run_size<1024>(cfg, p, r);
+    case 2048: return run_size<2048>(cfg, p, r);
+    case 4096: return run_size<4096>(cfg, p, r);
+    default: return false;
+  }
+}
+
+std::vector<std::string> split(const std::string &s) {
+  std::vector<std::string> out;
+  size_t                   start = 0;
+  while (start <= s.size()) {
+    const size_t end = s.find(',', start);
+    if (end == std::string::npos) {
+      if (start < s.size()) out.push_back(s.substr(start));
+      break;
+    }
+    if (end > start) out.push_back(s.substr(start, end - start));
+    start = end + 1;
+  }
+  return out;
+}
+
+std::vector<size_t> split_numbers(const std::string &s) {
+  std::vector<size_t> out;
+  for (const auto &v : split(s)) out.push_back(std::strtoull(v.c_str(), nullptr, 10));
+  return out;
+}
+
+void usage(const char *argv0) {
+  std::fprintf(stderr,
+      "usage: %s [--items N] [--repeat R] [--sizes 4,8,...] [--capacities 512,...]\n"
+      "          [--strategies hybrid,spin,backoff,yield,block] [--index shared,cached]\n"
+      "          [--layouts dense,prefetch,padded,swizzled]\n"
+      "          [--pin PRODUCER,CONSUMER|auto] [--format json|csv] [--output FILE]\n"
+      "element sizes: 4 8 16 32 64 128 256 512 1024 2048 4096\n",
+      argv0);
+}
+
+bool parse(int argc, char **argv, Config &cfg) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+    const std::string val = argv[++i];
+
+    if (arg == "--items") {
+      cfg.items = std::strtoull(val.c_str(), nullptr, 10);
+    } else if (arg == "--repeat") {
+      cfg.repeat = std::strtoull(val.c_str(), nullptr, 10);
+    } else if (arg == "--sizes") {
+      cfg.sizes = split_numbers(val);
+    } else if (arg == "--capacities") {
+      cfg.capacities = split_numbers(val);
+    } else if (arg == "--strategies") {
+      cfg.strategies = split(val);
+    } else if (arg == "--index") {
+      cfg.indices = split(val);
+    } else if (arg == "--layouts") {
+      cfg.layouts = split(val);
+    } else if (arg == "--pin" && val == "auto") {
+      const auto pair = ringmaster::findSharedCachePair(3);
+      if (pair) {
+        cfg.producer_cpu = pair->producer;
+        cfg.consumer_cpu = pair->consumer;
+        cfg.numa_node    = pair->numa_node;
+      } else {
+        std::fprintf(stderr, "--pin auto: no two cores share an L3; running unpinned\n");
+      }
+    } else if (arg == "--pin") {
+      const auto cpus = split_numbers(val);
+      if (cpus.size() != 2) return false;
+      cfg.producer_cpu = static_cast<int>(cpus[0]);
+      cfg.consumer_cpu = static_cast<int>(cpus[1]);
+    } else if (arg == "--format") {
+      if (val != "json" && val != "csv") return false;
+      cfg.csv = (val == "csv");
+    } else if (arg == "--output") {
+      cfg.output = val;
+    } else {
+      return false;
+    }
+  }
+  return cfg.items > 0 && cfg.repeat > 0;
+}
+
+void write_csv(std::FILE *f, const std::vector<Result> &results) {
+  std::fprintf(f,
+      "strategy,index,layout,element_size,capacity,run,seconds,items_per_sec,mb_per_sec,"
+      "push_spin_pct,pop_spin_pct,push_block_pct,pop_block_pct,"
+      "p50_ns,p90_ns,p99_ns,p999_ns,max_ns,valid\n");
+  for (const auto &r : results) {
+    std::fprintf(f,
+        "%s,%s,%s,%zu,%zu,%zu,%.6f,%.0f,%.2f,%.4f,%.4f,%.4f,%.4f,%.0f,%.0f,%.0f,%.0f,%.0f,%d\n",
+        r.strategy.c_str(),
+        r.index.c_str(),
+        r.layout.c_str(),
+        r.element_size,
+        r.capacity,
+        r.run,
+        r.seconds,
+        r.items_per_sec,
+        r.mb_per_sec,
+        r.push_spin_pct,
+        r.pop_spin_pct,
+        r.push_block_pct,
+        r.pop_block_pct,
+        r.p50_ns,
+        r.p90_ns,
+        r.p99_ns,
+        r.p999_ns,
+        r.max_ns,
+        r.valid ? 1 : 0);
+  }
+}
+
+void write_json(std::FILE *f, const Config &cfg, const std::vector<Result> &results) {
+  std::fprintf(f, "{\n");
+  std::fprintf(f, "  \"benchmark\": \"ringmaster_bench\",\n");
+  std::fprintf(f, "  \"cache_line_size\": %d,\n", CACHE_LINE_SIZE);
+  std::fprintf(f, "  \"interference_size\": %d,\n", DESTRUCTIVE_INTERFERENCE_SIZE);
+  std::fprintf(f, "  \"l1d_cache_size\": %d,\n", L1D_CACHE_SIZE);
+  std::fprintf(f, "  \"l2_cache_size\": %d,\n", L2_CACHE_SIZE);
+  std::fprintf(f, "  \"smt_width\": %d,\n", SMT_WIDTH);
+  std::fprintf(f, "  \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+  std::fprintf(f, "  \"items\": %zu,\n", cfg.items);
+  std::fprintf(f, "  \"producer_cpu\": %d,\n", cfg.producer_cpu);
+  std::fprintf(f, "  \"consumer_cpu\": %d,\n", cfg.consumer_cpu);
+  std::fprintf(f, "  \"latency_sample\": %zu,\n", LATENCY_SAMPLE);
+  std::fprintf(f, "  \"results\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto &r = results[i];
+    std::fprintf(f,
+        "    {\"strategy\": \"%s\", \"index\": \"%s\", \"layout\": \"%s\", \"element_size\": %zu, "
+        "\"capacity\": %zu, \"run\": %zu, \"seconds\": %.6f, \"items_per_sec\": %.0f, "
+        "\"mb_per_sec\": %.2f, \"push_spin_pct\": %.4f, \"pop_spin_pct\": %.4f, "
+        "\"push_block_pct\": %.4f, \"pop_block_pct\": %.4f, "
+        "\"latency_ns\": {\"p50\": %.0f, \"p90\": %.0f, \"p99\": %.0f, \"p999\": %.0f, "
+        "\"max\": %.0f}, \"valid\": %s}%s\n",
+        r.strategy.c_str(),
+        r.index.c_str(),
+        r.layout.c_str(),
+        r.element_size,
+        r.capacity,
+        r.run,
+        r.seconds,
+        r.items_per_sec,
+        r.mb_per_sec,
+        r.push_spin_pct,
+        r.pop_spin_pct,
+        r.push_block_pct,
+        r.pop_block_pct,
+        r.p50_ns,
+        r.p90_ns,
+        r.p99_ns,
+        r.p999_ns,
+        r.max_ns,
+        r.valid ? "true" : "false",
+        i + 1 < results.size() ? "," : "");
+  }
+  std::fprintf(f, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Config cfg;
+  if (!parse(argc, argv, cfg)) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<Result> results;
+  for (const auto &strategy : cfg.strategies) {
+    for (const auto &index : cfg.indices) {
+      for (const auto &layout : cfg.layouts) {
+        for (size_t cap : cfg.capacities) {
+          for (size_t size : cfg.sizes) {
+            for (size_t run = 0; run < cfg.repeat; ++run) {
+              Result r;
+              try {
+                if (!dispatch(cfg, size, Run{strategy, index, layout, cap, run}, r)) {
+                  std::fprintf(stderr,
+                      "skipping unsupported combination: size=%zu strategy=%s index=%s layout=%s\n",
+                      size,
+                      strategy.c_str(),
+                      index.c_str(),
+                      layout.c_str());
+                  break;
+                }
+              } catch (const std::exception &e) {
+                std::fprintf(stderr, "skipping capacity %zu: %s\n", cap, e.what());
+                break;
+              }
+              std::fprintf(stderr,
+                  "%-7s %-6s %-8s %5zu B cap %-6zu run %zu: %12.0f items/s  p99 %8.0f ns\n",
+                  r.strategy.c_str(),
+                  r.index.c_str(),
+                  r.layout.c_str(),
+                  r.element_size,
+                  r.capacity,
+                  r.run,
+                  r.items_per_sec,
+                  r.p99_ns);
+              results.push_back(std::move(r));
+            }
+          }
+        }
+      }
+    }
+  }
+
+  std::FILE *out = stdout;
+  if (!cfg.output.empty()) {
+    out = std::fopen(cfg.output.c_str(), "w");
+    if (!out) {
+      std::perror(cfg.output.c_str());
+      return 1;
+    }
+  }
+  if (cfg.csv) {
+    write_csv(out, results);
+  } else {
+    write_json(out, cfg, results);
+  }
+  if (out != stdout) std::fclose(out);
+
+  const bool all_valid =
+      std::all_of(results.begin(), results.end(), [](const Result &r) { return r.valid; });
+  return all_valid ? 0 : 1;
+}
@@ -0,0 +1,82 @@
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+
+#include "RingMasterAsync.hh"
+#include "check.hh"
+
+/**
+ * @brief Coroutine ring: a producer and a consumer coroutine move move-only
+ * elements in order, whichever side starts first, and when each side runs on
+ * its own thread and resumes the other inline
+ */
+
+static constexpr uint64_t ITEMS = 100000;
+
+/**
+ * @struct Task
+ * @brief Fire-and-forget coroutine that runs eagerly and frees itself
+ */
+struct Task {
+  struct promise_type {
+    Task               get_return_object() noexcept { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void               return_void() noexcept {}
+    void               unhandled_exception() noexcept { std::terminate(); }
+  };
+};
+
+using Ring = AsyncRingMaster<std::unique_ptr<uint64_t>, 16>;
+
+static std::atomic<int> finished{0};
+
+static Task produce(Ring &ring) {
+  for (uint64_t i = 0; i < ITEMS; ++i) co_await ring.async_push(std::make_unique<uint64_t>(i));
+  finished.fetch_add(1);
+}
+
+static Task consume(Ring &ring) {
+  for (uint64_t expected = 0; expected < ITEMS; ++expected) {
+    auto item = co_await ring.async_pop();
+    CHECK(item && *item == expected);
+  }
+  finished.fetch_add(1);
+}
+
+int main() {
+  // Single thread, producer first: it suspends on the full ring and each
+  // pop resumes it
+  {
+    static Ring ring;
+    finished = 0;
+    produce(ring);
+    consume(ring);
+    CHECK(finished == 2 && ring.isEmpty());
+  }
+
+  // Single thread, consumer first: it suspends on the empty ring
+  {
+    static Ring ring;
+    finished = 0;
+    consume(ring);
+    produce(ring);
+    CHECK(finished == 2 && ring.isEmpty());
+  }
+
+  // Two threads: each coroutine starts on its own thread and may be resumed
+  // on the other
+  {
+    static Ring ring;
+    finished = 0;
+    std::thread producer([] { produce(ring); });
+    std::thread consumer([] { consume(ring); });
+    producer.join();
+    consumer.join();
+    CHECK(finished == 2 && ring.isEmpty());
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Batch calls: push_n() and pop_n() split a batch at the wrap point,
+ * keep FIFO order and stop at the free space or the available elements
+ *
+ * uint64_t takes the bulk copy paths for contiguous ranges and the
+ * element-wise ones for other iterators. std::string always takes the
+ * element-wise paths: copying from lvalue iterators leaves the source
+ * intact, and pushing from a std::move_iterator leaves it moved-from.
+ */
+
+/** A string too long for the small-string buffer, so a move really steals it */
+static std::string text(int i) { return "element number " + std::to_string(i) + " of the batch"; }
+
+static void trivially_copyable() {
+  RingMaster<uint64_t, 8> ring;
+
+  // Move head and tail to slot 6 so that a full batch wraps
+  std::array<uint64_t, 8> in{};
+  for (size_t i = 0; i < in.size(); ++i) in[i] = i;
+  CHECK(ring.push_n(in.begin(), 6) == 6);
+  std::array<uint64_t, 8> out{};
+  CHECK(ring.pop_n(out.begin(), 8) == 6 && out[5] == 5);
+
+  // Contiguous source and destination: two segments each way
+  for (size_t i = 0; i < in.size(); ++i) in[i] = 100 + i;
+  CHECK(ring.push_n(std::span<const uint64_t>(in)) == 8);
+  CHECK(ring.isFull() && ring.push_n(in.begin(), 1) == 0);
+  out = {};
+  CHECK(ring.pop_n(out.begin(), 5) == 5);
+  for (size_t i = 0; i < 5; ++i) CHECK(out[i] == 100 + i);
+
+  // Element-wise paths: a list source and a back_inserter destination
+  std::list<uint64_t> more{200, 201, 202, 203, 204, 205, 206};
+  CHECK(ring.push_n(more.begin(), more.size()) == 5); // only five slots free
+  std::vector<uint64_t> rest;
+  CHECK(ring.pop_n(std::back_inserter(rest), 16) == 8);
+  const std::vector<uint64_t> want{105, 106, 107, 200, 201, 202, 203, 204};
+  CHECK(rest == want && ring.isEmpty());
+}
+
+static void strings() {
+  RingMaster<std::string, 8> ring;
+
+  for (int i = 0; i < 6; ++i) CHECK(ring.push(text(i)));
+  CHECK(ring.remove(6) == 6);
+
+  // Copying across the wrap leaves the source intact
+  std::vector<std::string> src;
+  for (int i = 0; i < 8; ++i) src.push_back(text(i));
+  CHECK(ring.push_n(src.begin(), 3) == 3);
+  for (int i = 0; i < 8; ++i) CHECK(src[i] == text(i));
+
+  // Moving fills the remaining five slots and leaves those sources empty
+  CHECK(ring.push_n(std::make_move_iterator(src.begin() + 3), 5) == 5);
+  CHECK(ring.isFull());
+  for (int i = 0; i < 3; ++i) CHECK(src[i] == text(i));
+  for (int i = 3; i < 8; ++i) CHECK(src[i].empty());
+
+  // pop_n() moves every element out across the wrap, in order
+  std::array<std::string, 8> out;
+  CHECK(ring.pop_n(out.begin(), 8) == 8 && ring.isEmpty());
+  for (int i = 0; i < 8; ++i) CHECK(out[i] == text(i));
+}
+
+int main() {
+  trivially_copyable();
+  strings();
+  return 0;
+}
@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RingMasterBroadcast.hh"
+#include "check.hh"
+
+/**
+ * @brief Broadcast ring: in gated mode every reader thread sees every
+ * element in order; in lossy mode each reader sees increasing elements and
+ * accounts for the rest in dropped(reader)
+ *
+ * Gated mode carries std::string so that slot reuse and destruction of a
+ * non-trivial type are exercised.
+ */
+
+static constexpr size_t   READERS = 3;
+static constexpr uint64_t ITEMS   = 50000;
+
+static void gated() {
+  static BroadcastRingMaster<std::string, 64, READERS> ring;
+
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < READERS; ++r) {
+    readers.emplace_back([r] {
+      std::string value;
+      for (uint64_t expected = 0; expected < ITEMS; ++expected) {
+        CHECK(ring.pop_wait(r, value));
+        CHECK(value == std::to_string(expected));
+      }
+      CHECK(ring.isEmpty(r));
+    });
+  }
+  for (uint64_t i = 0; i < ITEMS; ++i) ring.push_wait(std::to_string(i));
+  for (auto &reader : readers) reader.join();
+}
+
+static void lossy() {
+  static BroadcastRingMaster<uint64_t, 64, READERS, true> ring;
+
+  std::vector<std::thread> readers;
+  for (size_t r = 0; r < READERS; ++r) {
+    readers.emplace_back([r] {
+      uint64_t value    = 0;
+      uint64_t received = 0;
+      int64_t  last     = -1;
+      while (last != static_cast<int64_t>(ITEMS - 1)) {
+        if (!ring.pop(r, value)) {
+          std::this_thread::yield();
+          continue;
+        }
+        CHECK(static_cast<int64_t>(value) > last);
+        last = static_cast<int64_t>(value);
+        ++received;
+      }
+      CHECK(received + ring.dropped(r) == ITEMS);
+    });
+  }
+  for (uint64_t i = 0; i < ITEMS; ++i) CHECK(ring.push(i));
+  for (auto &reader : readers) reader.join();
+}
+
+int main() {
+  gated();
+  lossy();
+  return 0;
+}
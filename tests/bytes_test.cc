@@ -0,0 +1,60 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+
+#include "RingMasterBytes.hh"
+#include "check.hh"
+
+/**
+ * @brief Byte ring: variable-length records arrive intact and in order
+ * across two threads, through both push() and try_claim()/commit()
+ *
+ * Record i is `i % 301` bytes long, so records of every size, including
+ * empty ones, wrap around the end of the buffer. Every third record is
+ * claimed larger than it is committed.
+ */
+
+static constexpr uint32_t ITEMS = 100000;
+
+static size_t record_size(uint32_t seq) noexcept { return seq % 301; }
+
+static std::byte record_byte(uint32_t seq, size_t at) noexcept {
+  return static_cast<std::byte>((seq * 31 + at) & 0xff);
+}
+
+int main() {
+  static ByteRingMaster<4096> ring;
+
+  std::thread producer([] {
+    std::byte record[301];
+    for (uint32_t i = 0; i < ITEMS; ++i) {
+      const size_t size = record_size(i);
+      for (size_t j = 0; j < size; ++j) record[j] = record_byte(i, j);
+
+      if (i % 3 == 0) {
+        std::span<std::byte> claimed;
+        while ((claimed = ring.try_claim(size + 16)).data() == nullptr) std::this_thread::yield();
+        std::copy(record, record + size, claimed.begin());
+        ring.commit(size);
+      } else {
+        while (!ring.push({record, size})) std::this_thread::yield();
+      }
+    }
+  });
+
+  for (uint32_t expected = 0; expected < ITEMS; ++expected) {
+    std::span<const std::byte> record;
+    while ((record = ring.peek()).data() == nullptr) std::this_thread::yield();
+
+    CHECK(record.size() == record_size(expected));
+    for (size_t j = 0; j < record.size(); ++j) CHECK(record[j] == record_byte(expected, j));
+    ring.release();
+  }
+  producer.join();
+
+  CHECK(ring.isEmpty() && ring.bytesUsed() == 0);
+  CHECK(ring.try_claim(ByteRingMaster<4096>::MaxRecord + 1).data() == nullptr);
+  return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief Fail the running test if @p expr is false
+ *
+ * Prints the expression and its location and exits with a non-zero status,
+ * which ctest reports as a failure. Unlike assert() it stays active under
+ * NDEBUG, since the tests are built with the library's optimised flags.
+ */
+#define CHECK(expr)                                                                     \
+  do {                                                                                  \
+    if (!(expr)) {                                                                      \
+      std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr);     \
+      std::exit(EXIT_FAILURE);                                                          \
+    }                                                                                   \
+  } while (0)
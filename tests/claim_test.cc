@@ -0,0 +1,99 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Zero-copy slots: try_claim() splits at the wrap point and hands out
+ * the same slots until commit(), committing fewer slots than claimed publishes
+ * only those, and peek()/release() stream elements across two threads
+ *
+ * The single-threaded part uses std::string so that only committed slots may
+ * hold constructed elements; a slot claimed but not committed must be free
+ * for the next claim.
+ */
+
+static constexpr uint64_t ITEMS = 200000;
+
+static void wrap_and_partial_commit() {
+  RingMaster<std::string, 8> ring;
+
+  // Move head and tail to slot 6 so that the next claim wraps
+  for (int i = 0; i < 6; ++i) CHECK(ring.push(std::to_string(i)));
+  CHECK(ring.remove(6) == 6);
+
+  auto claim = ring.try_claim(5);
+  CHECK(claim.size() == 5 && claim.first.size() == 2 && claim.second.size() == 3);
+  CHECK(claim.first.data() == ring.try_claim(5).first.data()); // same slots again
+
+  for (size_t i = 0; i < 3; ++i) std::construct_at(&claim[i], "claimed " + std::to_string(i));
+  ring.commit(3);
+  CHECK(ring.size() == 3);
+
+  // Only the three committed elements are visible, in order, across the wrap
+  auto view = ring.peek();
+  CHECK(view.size() == 3 && view.first.size() == 2 && view.second.size() == 1);
+  CHECK(view[0] == "claimed 0" && view[2] == "claimed 2");
+
+  // The uncommitted slots are claimed again, after the committed ones
+  auto rest = ring.try_claim(SIZE_MAX);
+  CHECK(rest.size() == 5 && rest.first.data() == claim.second.data() + 1);
+  std::construct_at(&rest[0], std::string("claimed 3"));
+  ring.commit(1);
+
+  // Releasing part of a peek leaves the rest in place
+  ring.release(2);
+  auto tail = ring.peek(1);
+  CHECK(tail.size() == 1 && tail[0] == "claimed 2");
+  ring.release(1);
+  CHECK(ring.pop() == std::string("claimed 3") && ring.isEmpty());
+  CHECK(ring.peek().empty());
+
+  // A full ring has nothing to claim
+  for (int i = 0; i < 8; ++i) CHECK(ring.push(std::to_string(i)));
+  CHECK(ring.try_claim(1).empty());
+}
+
+static void two_threads() {
+  static RingMaster<uint64_t, 64> ring;
+
+  // The producer claims up to 13 slots but commits only a prefix of them
+  std::thread producer([] {
+    uint64_t next = 0;
+    for (size_t round = 0; next < ITEMS; ++round) {
+      auto claim = ring.try_claim(13);
+      if (claim.empty()) {
+        std::this_thread::yield();
+        continue;
+      }
+      size_t n = 1 + round % claim.size();
+      if (n > ITEMS - next) n = ITEMS - next;
+      for (size_t i = 0; i < n; ++i) claim[i] = next++;
+      ring.commit(n);
+    }
+  });
+
+  // The consumer peeks up to 11 elements and releases a prefix of them
+  uint64_t expected = 0;
+  for (size_t round = 0; expected < ITEMS; ++round) {
+    auto view = ring.peek(11);
+    if (view.empty()) {
+      std::this_thread::yield();
+      continue;
+    }
+    const size_t n = 1 + round % view.size();
+    for (size_t i = 0; i < n; ++i) CHECK(view[i] == expected++);
+    ring.release(n);
+  }
+  producer.join();
+  CHECK(ring.isEmpty());
+}
+
+int main() {
+  wrap_and_partial_commit();
+  two_threads();
+  return 0;
+}
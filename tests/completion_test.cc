@@ -0,0 +1,142 @@
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RingMasterCompletion.hh"
+#include "check.hh"
+
+/**
+ * @brief Sequence numbers and CompletionWindow: peek_from()/acknowledge()
+ * address elements by sequence, out-of-order completions retire only as a
+ * prefix, and a dispatcher with two workers retires every element exactly
+ * once while a producer keeps pushing
+ */
+
+using Ring = RingMaster<int64_t, 256>;
+
+static constexpr int64_t ITEMS = 200000;
+
+static void sequences() {
+  RingMaster<std::string, 8> ring;
+  for (int i = 0; i < 6; ++i) CHECK(ring.push(std::to_string(i)));
+  CHECK(ring.sequence() == 0);
+
+  auto front = ring.peek_from(0, 2);
+  CHECK(front.size() == 2 && front[1] == "1");
+  auto rest = ring.peek_from(2);
+  CHECK(rest.size() == 4 && rest[0] == "2");
+  CHECK(ring.peek_from(6).empty());
+
+  ring.acknowledge(4);
+  CHECK(ring.sequence() == 4 && ring.size() == 2);
+  for (int i = 6; i < 12; ++i) CHECK(ring.push(std::to_string(i)));
+  auto wrapped = ring.peek_from(5, 100);
+  CHECK(wrapped.size() == 7 && wrapped[0] == "5" && wrapped[6] == "11");
+  CHECK(!wrapped.second.empty());
+}
+
+static void out_of_order() {
+  static Ring ring;
+
+  ringmaster::CompletionWindow<Ring, 64> window(ring);
+  for (int64_t i = 0; i < 200; ++i) CHECK(ring.push(i));
+
+  // The window caps claimed, unretired elements at 64
+  auto first  = window.claim(40);
+  auto second = window.claim(40);
+  CHECK(first.size() == 40 && second.size() == 24 && window.claim(40).size() == 0);
+  CHECK(window.inFlight() == 64);
+
+  // Nothing retires until the front of the window is complete
+  window.complete(second.seq, 24);
+  CHECK(window.retire() == 0);
+  window.complete(first.seq + 1, 39);
+  CHECK(window.retire() == 0);
+  window.complete(first.seq, 1);
+  CHECK(window.retire() == 64);
+  CHECK(ring.sequence() == 64 && ring.size() == 136);
+
+  auto next = window.claim(64);
+  CHECK(next.seq == 64 && next.size() == 64 && next.elements[0] == 64);
+}
+
+static void threaded() {
+  static Ring ring;
+
+  using Window = ringmaster::CompletionWindow<Ring, 128>;
+  Window window(ring);
+
+  std::mutex                lock;
+  std::deque<Window::Batch> queue;
+  bool                      stop = false;
+  std::atomic<int64_t>      sum{0};
+
+  std::thread producer([] {
+    for (int64_t i = 0; i < ITEMS;) {
+      if (ring.push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  std::vector<std::thread> workers;
+  for (int w = 0; w < 2; ++w) {
+    workers.emplace_back([&] {
+      for (;;) {
+        Window::Batch batch;
+        {
+          std::lock_guard<std::mutex> guard(lock);
+          if (queue.empty() && stop) return;
+          if (!queue.empty()) {
+            batch = queue.front();
+            queue.pop_front();
+          }
+        }
+        if (batch.size() == 0) {
+          std::this_thread::yield();
+          continue;
+        }
+        int64_t local = 0;
+        for (size_t i = 0; i < batch.size(); ++i) {
+          CHECK(batch.elements[i] == static_cast<int64_t>(batch.seq + i));
+          local += batch.elements[i];
+        }
+        sum.fetch_add(local, std::memory_order_relaxed);
+        window.complete(batch.seq, batch.size());
+      }
+    });
+  }
+
+  // Dispatcher: the ring's consumer thread
+  for (int64_t retired = 0; retired < ITEMS;) {
+    auto batch = window.claim(37);
+    if (batch.size()) {
+      std::lock_guard<std::mutex> guard(lock);
+      queue.push_back(batch);
+    }
+    retired += static_cast<int64_t>(window.retire());
+    if (!batch.size()) std::this_thread::yield();
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stop = true;
+  }
+  for (auto &worker : workers) worker.join();
+  producer.join();
+
+  CHECK(sum == ITEMS * (ITEMS - 1) / 2);
+  CHECK(ring.isEmpty() && window.inFlight() == 0);
+}
+
+int main() {
+  sequences();
+  out_of_order();
+  threaded();
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Runtime-capacity ring: FIFO order across two threads, close(),
+ * rejection of capacities that are not powers of two, and usesHugePages()
+ * reporting only huge page backing the kernel actually granted
+ *
+ * The kernel accepts MADV_HUGEPAGE exactly when it was built with THP
+ * support, which is also when it exposes /sys/kernel/mm/transparent_hugepage.
+ */
+
+static constexpr uint64_t ITEMS = 200000;
+
+int main() {
+  RingMaster<uint64_t, ringmaster::DynamicCapacity> ring(1024);
+  CHECK(ring.capacity() == 1024);
+
+  std::thread producer([&] {
+    for (uint64_t i = 0; i < ITEMS; ++i) CHECK(ring.push_wait(i));
+    ring.close();
+  });
+
+  uint64_t value    = 0;
+  uint64_t expected = 0;
+  while (ring.pop_wait(value)) CHECK(value == expected++);
+  producer.join();
+
+  CHECK(expected == ITEMS);
+  CHECK(ring.isClosed() && ring.isEmpty());
+
+  // After close() a waiting push fails instead of parking on a full ring
+  while (ring.push(uint64_t{0})) {}
+  CHECK(ring.isFull() && !ring.push_wait(uint64_t{0}));
+
+  bool threw = false;
+  try {
+    RingMaster<uint64_t, ringmaster::DynamicCapacity> bad(1000);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  CHECK(threw);
+
+#if defined(__linux__)
+  using Elems = RingMaster<uint64_t, ringmaster::DynamicCapacity>;
+  const bool thp = std::filesystem::exists("/sys/kernel/mm/transparent_hugepage");
+  Elems      heap(1024, ringmaster::HugePages::None);
+  Elems      transparent(1024, ringmaster::HugePages::Transparent);
+  Elems      explicit_pages(1024, ringmaster::HugePages::Explicit);
+  CHECK(!heap.usesHugePages());
+  CHECK(transparent.usesHugePages() == thp);
+  CHECK(explicit_pages.usesHugePages() || !thp); // MAP_HUGETLB, else as Transparent
+  CHECK(transparent.push(uint64_t{1}) && transparent.pop() == uint64_t{1});
+#endif
+  return 0;
+}
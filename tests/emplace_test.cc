@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief In-place calls: emplace() builds the element in its slot without a
+ * move, consume() hands it to the visitor without one either, and
+ * consume()/consume_all() visit elements in FIFO order across the wrap point,
+ * with consume_all() stopping at `max` and advancing tail_ by exactly the
+ * batch it visited
+ */
+
+struct Tracked {
+  static inline int moves = 0;
+
+  int         id;
+  std::string name;
+
+  Tracked(int i, std::string n) : id(i), name(std::move(n)) {}
+  Tracked(Tracked &&other) noexcept : id(other.id), name(std::move(other.name)) { ++moves; }
+  Tracked &operator=(Tracked &&other) noexcept {
+    id   = other.id;
+    name = std::move(other.name);
+    ++moves;
+    return *this;
+  }
+};
+
+static void in_place() {
+  RingMaster<Tracked, 4> ring;
+  CHECK(ring.emplace(1, "one") && ring.emplace(2, "two"));
+  CHECK(Tracked::moves == 0);
+
+  int seen = 0;
+  CHECK(ring.consume([&seen](Tracked &t) {
+    CHECK(t.id == 1 && t.name == "one");
+    ++seen;
+  }));
+  CHECK(seen == 1 && Tracked::moves == 0 && ring.size() == 1);
+
+  // A full ring constructs nothing
+  CHECK(ring.emplace(3, "three") && ring.emplace(4, "four") && ring.emplace(5, "five"));
+  CHECK(!ring.emplace(6, "six") && ring.size() == 4);
+  CHECK(Tracked::moves == 0);
+}
+
+static void across_the_wrap() {
+  RingMaster<int, 8> ring;
+
+  // Move head and tail to slot 6 so the next eight elements wrap
+  for (int i = 0; i < 6; ++i) CHECK(ring.push(i));
+  int expected = 0;
+  CHECK(ring.consume_all([&expected](int &v) { CHECK(v == expected++); }) == 6);
+  CHECK(ring.sequence() == 6);
+
+  for (int i = 6; i < 14; ++i) CHECK(ring.push(i));
+  CHECK(ring.isFull());
+
+  CHECK(ring.consume([&expected](int &v) { CHECK(v == expected++); }));
+  CHECK(ring.sequence() == 7);
+
+  // Stops at max even though more is available
+  CHECK(ring.consume_all([&expected](int &v) { CHECK(v == expected++); }, 3) == 3);
+  CHECK(ring.sequence() == 10 && ring.size() == 4);
+
+  CHECK(ring.consume_all([&expected](int &v) { CHECK(v == expected++); }) == 4);
+  CHECK(expected == 14 && ring.sequence() == 14 && ring.isEmpty());
+
+  CHECK(!ring.consume([](int &) { CHECK(false); }));
+  CHECK(ring.consume_all([](int &) { CHECK(false); }) == 0);
+}
+
+int main() {
+  in_place();
+  across_the_wrap();
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <cstddef>
+#include <thread>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "RingMasterEventFd.hh"
+#include "check.hh"
+
+/**
+ * @brief eventfd ring: an epoll loop fed by a producer thread receives every
+ * element in order, fd() goes quiet once drained, and a poll() that runs out
+ * of budget leaves fd() readable
+ */
+
+static constexpr size_t ITEMS = 200000;
+
+/** Wait up to `timeout_ms` for fd() to become readable */
+static bool readable(int epoll, int timeout_ms) {
+  epoll_event event{};
+  return ::epoll_wait(epoll, &event, 1, timeout_ms) == 1;
+}
+
+int main() {
+  static EventFdRingMaster<size_t, 256> ring;
+
+  const int epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  CHECK(epoll >= 0);
+  epoll_event event{};
+  event.events = EPOLLIN;
+  CHECK(::epoll_ctl(epoll, EPOLL_CTL_ADD, ring.fd(), &event) == 0);
+
+  std::thread producer([] {
+    for (size_t i = 0; i < ITEMS; ++i) {
+      while (!ring.push(i)) std::this_thread::yield();
+    }
+  });
+
+  size_t next = 0;
+  while (next < ITEMS) {
+    CHECK(readable(epoll, 5000));
+    ring.poll([&next](size_t &value) noexcept { CHECK(value == next++); }, 64);
+  }
+  producer.join();
+
+  // Drained and armed: nothing to report
+  CHECK(ring.isEmpty() && !readable(epoll, 0));
+
+  // One push wakes the loop again; a poll() with budget to spare quiets it
+  CHECK(ring.push(size_t{7}));
+  CHECK(readable(epoll, 0));
+  CHECK(ring.poll([](size_t &value) noexcept { CHECK(value == 7); }) == 1);
+  CHECK(!readable(epoll, 0));
+
+  // A poll() that runs out of budget stays readable until the ring is empty
+  size_t values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  CHECK(ring.push_n(values, 10) == 10);
+  CHECK(ring.poll([](size_t &) noexcept {}, 4) == 4);
+  CHECK(readable(epoll, 0));
+  CHECK(ring.poll([](size_t &) noexcept {}) == 6);
+  CHECK(!readable(epoll, 0));
+
+  ::close(epoll);
+  return 0;
+}
@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "RingMasterShm.hh"
+#include "check.hh"
+
+/**
+ * @brief File-backed journal: reopening after a write resumes at the
+ * persisted indices with the unconsumed elements intact, and in Msync mode at
+ * the head of the last completed flush()
+ *
+ * The first handle is written by a producer and a consumer thread, so the
+ * reopened journal must also see what crossed between them.
+ */
+
+using ringmaster::Durability;
+
+static constexpr uint64_t ITEMS    = 50000;
+static constexpr size_t   CAPACITY = 1024;
+
+int main() {
+  const std::string name = "ringmaster_journal_test_" + std::to_string(::getpid());
+  const std::string path = (std::filesystem::temp_directory_path() / name).string();
+
+  // Two threads stream ITEMS elements and then leave CAPACITY / 2 unread
+  {
+    auto journal = ShmRingMaster<uint64_t>::createFile(path, CAPACITY);
+
+    std::thread consumer([&journal] {
+      uint64_t value = 0;
+      for (uint64_t expected = 0; expected < ITEMS; ++expected) {
+        journal.pop_wait(value);
+        CHECK(value == expected);
+      }
+    });
+    for (uint64_t i = 0; i < ITEMS; ++i) journal.push_wait(i);
+    consumer.join();
+
+    for (uint64_t i = 0; i < CAPACITY / 2; ++i) CHECK(journal.push(ITEMS + i));
+  }
+
+  // Reopen: the backlog is still there, in order, behind the persisted tail
+  {
+    auto journal = ShmRingMaster<uint64_t>::openFile(path);
+    CHECK(journal.size() == CAPACITY / 2);
+
+    uint64_t expected = ITEMS;
+    CHECK(journal.consume_all([&expected](const uint64_t &value) noexcept {
+      CHECK(value == expected++);
+    }, 10) == 10);
+
+    // flush() records everything published so far as durable; the two
+    // pushes after it are not
+    CHECK(journal.flush());
+    CHECK(journal.push(uint64_t{1}) && journal.push(uint64_t{2}));
+  }
+
+  // A PageCache reopen keeps the unflushed pushes; an Msync reopen resumes at
+  // the durable head and drops them
+  {
+    auto journal = ShmRingMaster<uint64_t>::openFile(path);
+    CHECK(journal.size() == CAPACITY / 2 - 10 + 2);
+  }
+  {
+    auto journal = ShmRingMaster<uint64_t>::openFile(path, Durability::Msync);
+    CHECK(journal.size() == CAPACITY / 2 - 10);
+
+    uint64_t value    = 0;
+    uint64_t expected = ITEMS + 10;
+    while (journal.pop(value)) CHECK(value == expected++);
+    CHECK(expected == ITEMS + CAPACITY / 2);
+  }
+
+  // A journal written for another element type is refused
+  bool threw = false;
+  try {
+    ShmRingMaster<uint32_t>::openFile(path);
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  CHECK(threw);
+
+  std::filesystem::remove(path);
+  return 0;
+}
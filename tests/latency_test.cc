@@ -0,0 +1,117 @@
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "RingMasterLatency.hh"
+#include "check.hh"
+
+/**
+ * @brief Instrumented ring: FIFO order across two threads, one latency sample
+ * per delivered element, and pop_wait() failing without a sample after close()
+ *
+ * The element type has no default constructor, which the wrapper must not
+ * require. A push() to a full ring must leave the caller's value intact for
+ * the retry, a throwing copy must leave the ring unchanged, and push_wait()
+ * must not count the time it spends blocked on a full ring.
+ */
+
+static constexpr uint32_t ITEMS = 100000;
+
+struct Order {
+  explicit Order(uint32_t id) noexcept : id(id) {}
+  uint32_t id;
+};
+
+struct Fragile {
+  Fragile() = default;
+  Fragile(const Fragile &) { throw std::runtime_error("copy"); }
+  Fragile(Fragile &&) noexcept = default;
+  Fragile &operator=(Fragile &&) noexcept = default;
+};
+
+static void full_ring() {
+  // A failed push does not move from its argument
+  {
+    InstrumentedRingMaster<std::string, 2> ring;
+    CHECK(ring.push(std::string("a")) && ring.push(std::string("b")));
+
+    std::string value(64, 'c');
+    CHECK(!ring.push(std::move(value)));
+    CHECK(value == std::string(64, 'c'));
+    CHECK(ring.occupancyHighWater() == 2);
+
+    std::string out;
+    CHECK(ring.pop(out) && out == "a");
+    CHECK(ring.push(std::move(value)));
+    CHECK(ring.pop(out) && out == "b" && ring.pop(out) && out == std::string(64, 'c'));
+    CHECK(ring.latency().snapshot().count() == 3);
+  }
+
+  // A throwing copy leaves the ring as it was
+  {
+    InstrumentedRingMaster<Fragile, 2> ring;
+    static_assert(!noexcept(ring.push(std::declval<const Fragile &>())));
+    static_assert(noexcept(ring.push(Fragile{})));
+
+    const Fragile original;
+    bool          threw = false;
+    try {
+      ring.push(original);
+    } catch (const std::runtime_error &) {
+      threw = true;
+    }
+    CHECK(threw && ring.isEmpty());
+    CHECK(ring.push(Fragile{}) && ring.size() == 1);
+  }
+
+  // The stamp is taken once push_wait() finds a free slot
+  {
+    using namespace std::chrono_literals;
+    static InstrumentedRingMaster<uint32_t, 2> ring;
+    CHECK(ring.push(uint32_t{0}) && ring.push(uint32_t{1}));
+
+    std::thread producer([] { CHECK(ring.push_wait(uint32_t{2})); });
+    std::this_thread::sleep_for(200ms); // producer blocks on the full ring
+
+    uint32_t value = 0;
+    CHECK(ring.pop_wait(value) && value == 0);
+    producer.join();
+    const auto before = ring.latency().snapshot();
+    CHECK(ring.pop_wait(value) && value == 1 && ring.pop_wait(value) && value == 2);
+
+    // Elements 0 and 1 waited out the sleep, element 2 did not
+    const auto snap = ring.latency().snapshot();
+    CHECK(before.count() == 1 && snap.count() == 3);
+    CHECK(ring.toNanos(before.max()) >= 150e6);
+    CHECK(ring.toNanos(snap.percentile(0.0)) < 100e6);
+  }
+}
+
+int main() {
+  full_ring();
+
+  static InstrumentedRingMaster<Order, 64> ring;
+
+  std::thread producer([] {
+    for (uint32_t i = 0; i < ITEMS; ++i) CHECK(ring.push_wait(Order(i)));
+    ring.close();
+  });
+
+  Order    order(0);
+  uint32_t expected = 0;
+  while (ring.pop_wait(order)) CHECK(order.id == expected++);
+  producer.join();
+
+  CHECK(expected == ITEMS);
+  CHECK(ring.isClosed() && ring.isEmpty());
+  CHECK(!ring.pop_wait(order));
+
+  const auto snap = ring.latency().snapshot();
+  CHECK(snap.count() == ITEMS);
+  CHECK(snap.percentile(0.5) <= snap.max());
+  CHECK(ring.occupancyHighWater() <= ring.capacity());
+  return 0;
+}
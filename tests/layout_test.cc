@@ -0,0 +1,188 @@
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "RingMasterCompletion.hh"
+#include "check.hh"
+
+/**
+ * @brief Ring layouts: a CompactLayout ring keeps FIFO order across two
+ * threads, narrow indices wrap many times without losing elements,
+ * HugePageLayout places the slots on a huge page boundary, and PaddedLayout
+ * and SwizzledLayout rings with consumer prefetch keep FIFO order over many
+ * wraps
+ *
+ * A 16-bit index wraps every 65536 positions, so the wrap-around paths that
+ * a 32-bit CompactLayout ring only reaches after 2^32 elements run here in a
+ * few hundred thousand.
+ */
+
+using ringmaster::DenseLayout;
+using ringmaster::HybridWait;
+using ringmaster::NullStats;
+using ringmaster::PaddedLayout;
+using ringmaster::SwizzledLayout;
+
+using CompactLayout  = ringmaster::CompactLayout<>;
+using NarrowLayout   = ringmaster::RingLayout<DenseLayout<>, uint16_t>;
+using HugePageLayout = ringmaster::HugePageLayout<>;
+
+using Compact = RingMaster<uint64_t, 64, false, HybridWait<>, NullStats, CompactLayout>;
+using Narrow  = RingMaster<uint64_t, 64, false, HybridWait<>, NullStats, NarrowLayout>;
+using Huge    = RingMaster<uint64_t, 1024, false, HybridWait<>, NullStats, HugePageLayout>;
+
+using PaddedRing   = RingMaster<uint64_t, 64, true, HybridWait<>, NullStats, PaddedLayout<4>>;
+using SwizzledRing = RingMaster<uint64_t, 64, true, HybridWait<>, NullStats, SwizzledLayout<8>>;
+
+static constexpr uint64_t ITEMS = 200000; // > 3 wraps of a 16-bit index
+
+// CompactLayout drops the waiter flags, and with them the waiting calls
+template<typename RING>
+concept Waits = requires(RING &ring, uint64_t &value) { ring.pop_wait(value); };
+static_assert(!Waits<Compact> && Waits<Narrow>);
+
+static Huge huge;
+
+// In a 64-slot ring neighbouring indices sit a line apart, index LINES comes
+// back to the first line, and the mapping wraps with the index
+static constexpr size_t LINE  = CACHE_LINE_SIZE / sizeof(uint64_t);
+static constexpr size_t LINES = 64 / LINE;
+static_assert(SwizzledLayout<>::position<uint64_t>(1, 63) == LINE);
+static_assert(SwizzledLayout<>::position<uint64_t>(LINES, 63) == 1);
+static_assert(SwizzledLayout<>::position<uint64_t>(64 + LINES + 1, 63) == LINE + 1);
+static_assert(PaddedLayout<>::slot_bytes<uint64_t> == CACHE_LINE_SIZE);
+
+static void compact_two_threads() {
+  static Compact ring;
+
+  std::thread producer([] {
+    for (uint64_t i = 0; i < ITEMS;) {
+      if (ring.push(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint64_t value = 0;
+  for (uint64_t expected = 0; expected < ITEMS;) {
+    if (ring.pop(value)) {
+      CHECK(value == expected++);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  CHECK(ring.isEmpty());
+}
+
+static void narrow_wraps() {
+  // Blocking calls, size() and close() across the wrap
+  {
+    static Narrow ring;
+
+    std::thread producer([] {
+      for (uint64_t i = 0; i < ITEMS; ++i) CHECK(ring.push_wait(i));
+      ring.close();
+    });
+    uint64_t value    = 0;
+    uint64_t expected = 0;
+    while (ring.pop_wait(value)) {
+      CHECK(value == expected++);
+      CHECK(ring.size() <= ring.capacity());
+    }
+    producer.join();
+    CHECK(expected == ITEMS && ring.isEmpty());
+  }
+
+  // sequence(), peek_from() and acknowledge() wrap with the index, while
+  // the window's size_t counters keep going
+  {
+    static Narrow ring;
+
+    ringmaster::CompletionWindow<Narrow, 64> window(ring);
+
+    uint64_t pushed = 0;
+    uint64_t seen   = 0;
+    while (seen < ITEMS) {
+      while (ring.push(pushed)) ++pushed;
+      auto batch = window.claim(7);
+      CHECK(batch.size() > 0);
+      for (size_t i = 0; i < batch.size(); ++i) CHECK(batch.elements[i] == seen++);
+      window.complete(batch.seq, batch.size());
+      window.retire();
+    }
+    CHECK(ring.sequence() == (seen & 0xffff));
+  }
+
+  // Capacities an index type cannot address are refused
+  bool threw = false;
+  try {
+    RingMaster<uint8_t, ringmaster::DynamicCapacity, false, HybridWait<>, NullStats, NarrowLayout>
+        ring(1 << 16);
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  CHECK(threw);
+}
+
+static void swizzle_is_a_permutation() {
+  bool used[64] = {};
+  for (size_t i = 0; i < 64; ++i) {
+    const size_t pos = SwizzledLayout<>::position<uint64_t>(i, 63);
+    CHECK(pos < 64 && !used[pos]);
+    used[pos] = true;
+  }
+}
+
+// Single and batch calls on both sides, so each slot is reached through
+// every path many times over
+template<typename RING> static void round_trip() {
+  static RING ring;
+
+  std::thread producer([] {
+    uint64_t batch[5];
+    for (uint64_t i = 0; i < ITEMS;) {
+      if (i % 3 == 0) {
+        CHECK(ring.push_wait(i++));
+        continue;
+      }
+      size_t n = 0;
+      for (; n < 5 && i + n < ITEMS; ++n) batch[n] = i + n;
+      const size_t pushed = ring.push_n(batch, n);
+      if (pushed) {
+        ring.wakeConsumer();
+      } else {
+        std::this_thread::yield();
+      }
+      i += pushed;
+    }
+    ring.close();
+  });
+
+  uint64_t value    = 0;
+  uint64_t expected = 0;
+  uint64_t batch[7];
+  while (ring.pop_wait(value)) {
+    CHECK(value == expected++);
+    const size_t n = ring.pop_n(batch, 7);
+    if (n) ring.wakeProducer();
+    for (size_t i = 0; i < n; ++i) CHECK(batch[i] == expected++);
+  }
+  producer.join();
+  CHECK(expected == ITEMS && ring.isEmpty());
+}
+
+int main() {
+  CHECK(reinterpret_cast<uintptr_t>(&huge) % ringmaster::detail::HUGE_PAGE_SIZE == 0);
+  CHECK(huge.push(uint64_t{1}) && huge.pop() == uint64_t{1});
+
+  compact_two_threads();
+  narrow_wraps();
+  swizzle_is_a_permutation();
+  round_trip<PaddedRing>();
+  round_trip<SwizzledRing>();
+  return 0;
+}
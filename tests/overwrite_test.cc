@@ -0,0 +1,68 @@
+#include <cstdint>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Overwrite-oldest ring: lapping skips to the oldest live element, and
+ * across two threads the consumer sees untorn elements in increasing order
+ * with every element either delivered or counted in dropped()
+ *
+ * The element type has no default constructor, which pop() must not require.
+ */
+
+static constexpr size_t   CAPACITY = 64;
+static constexpr uint64_t ITEMS    = 200000;
+
+struct Sample {
+  explicit Sample(uint64_t seq) noexcept : seq(seq), check(~seq) {}
+  uint64_t seq;
+  uint64_t check; /**< ~seq, so a torn read shows up as a mismatch */
+};
+
+int main() {
+  // Single thread: after lapping twice, the first element read is the oldest
+  // one the producer has not reached again
+  {
+    static OverwriteRingMaster<Sample, CAPACITY> ring;
+
+    const uint64_t pushed = 2 * CAPACITY + 5;
+    for (uint64_t i = 0; i < pushed; ++i) ring.push(Sample(i));
+
+    auto first = ring.pop();
+    CHECK(first && first->seq == pushed - CAPACITY + 1);
+    CHECK(ring.dropped() == first->seq);
+    for (uint64_t i = first->seq + 1; i < pushed; ++i) {
+      auto next = ring.pop();
+      CHECK(next && next->seq == i);
+    }
+    CHECK(!ring.pop() && ring.isEmpty());
+  }
+
+  // Two threads: an unthrottled producer laps the consumer at will
+  static OverwriteRingMaster<Sample, CAPACITY> ring;
+
+  std::thread producer([] {
+    for (uint64_t i = 0; i < ITEMS; ++i) ring.push(Sample(i));
+  });
+
+  Sample   sample(0);
+  uint64_t received = 0;
+  int64_t  last     = -1;
+  while (last != static_cast<int64_t>(ITEMS - 1)) {
+    if (!ring.pop(sample)) {
+      std::this_thread::yield();
+      continue;
+    }
+    CHECK(sample.check == ~sample.seq);
+    CHECK(static_cast<int64_t>(sample.seq) > last);
+    last = static_cast<int64_t>(sample.seq);
+    ++received;
+  }
+  producer.join();
+
+  CHECK(received + ring.dropped() == ITEMS);
+  CHECK(!ring.pop(sample));
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "RingMasterPipeline.hh"
+#include "check.hh"
+
+/**
+ * @brief Pipeline: elements flow through three stage threads in order, a
+ * stage returning std::nullopt drops elements, close() delivers everything
+ * pushed before it, and report() reads zero rates before start()
+ *
+ * Half the input goes through the non-waiting push(), which must wake a
+ * first stage parked on an empty ring. A pipeline whose Batch exceeds its
+ * ring Capacity checks that stages forwarding full batches keep waking
+ * each other.
+ */
+
+static constexpr int64_t ITEMS = 100000;
+
+int main() {
+  int64_t next = 1; // odd inputs survive stage 1, doubled by stage 0
+  int64_t seen = 0;
+  {
+    auto pipeline = ringmaster::makePipeline<int64_t, 64, 16>(
+        [](int64_t &x) noexcept { return x * 2; },
+        [](int64_t &x) noexcept -> std::optional<int64_t> {
+          if (x % 4 == 0) return std::nullopt;
+          return x;
+        },
+        [&](int64_t &x) noexcept {
+          CHECK(x == 2 * next);
+          next += 2;
+          ++seen;
+        });
+
+    for (const auto &stage : pipeline.report()) CHECK(stage.items == 0 && stage.rate == 0.0);
+
+    pipeline.start();
+    for (int64_t i = 0; i < ITEMS / 2; ++i) CHECK(pipeline.push_wait(i));
+    for (int64_t i = ITEMS / 2; i < ITEMS; ++i) {
+      while (!pipeline.push(i)) std::this_thread::yield();
+    }
+    pipeline.close();
+    pipeline.join();
+
+    const auto report = pipeline.report();
+    CHECK(report[0].items == ITEMS && report[1].items == ITEMS && report[2].items == ITEMS / 2);
+    CHECK(report[0].occupancy == 0 && report[2].capacity == 64);
+    CHECK(!pipeline.push(int64_t{1}) && !pipeline.push_wait(int64_t{1}));
+  }
+  CHECK(seen == ITEMS / 2);
+
+  // Batches larger than the rings: forward() must wake the next stage after
+  // each push_n() that fills its ring, or both stages park for good
+  {
+    int64_t delivered = 0;
+    {
+      auto pipeline = ringmaster::makePipeline<int64_t, 8, 64>(
+          [](int64_t &x) noexcept { return x; },
+          [&delivered](int64_t &x) noexcept {
+            CHECK(x == delivered++);
+            if (x % 512 == 0) std::this_thread::yield(); // slow sink
+          });
+      pipeline.start();
+      for (int64_t i = 0; i < ITEMS; ++i) CHECK(pipeline.push_wait(i));
+      pipeline.close();
+      pipeline.join();
+    }
+    CHECK(delivered == ITEMS);
+  }
+
+  // The destructor closes and drains a running pipeline
+  size_t length = 0;
+  {
+    auto pipeline = ringmaster::makePipeline<std::string, 8>(
+        [](std::string &s) noexcept { return s + "!"; },
+        [&length](std::string &s) noexcept { length += s.size(); });
+    pipeline.start();
+    CHECK(pipeline.push_wait(std::string("ab")));
+  }
+  CHECK(length == 3);
+  return 0;
+}
@@ -0,0 +1,67 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "RingMasterPool.hh"
+#include "check.hh"
+
+/**
+ * @brief Pooled ring: every buffer is acquired by at most one owner at a
+ * time, payloads arrive in publish order across two threads, and the whole
+ * pool is back on the free ring afterwards
+ */
+
+static constexpr size_t   POOL  = 64;
+static constexpr uint64_t ITEMS = 100000;
+
+struct Page {
+  uint64_t seq       = 0;
+  bool     in_flight = false; /**< Set by the producer, cleared by the consumer */
+  char     data[4096 - 16];
+};
+
+int main() {
+  auto pool = std::make_unique<PooledRingMaster<Page, POOL>>();
+  CHECK(pool->available() == POOL && pool->size() == 0);
+
+  // The pool holds exactly POOL distinct, padded buffers
+  Page *all[POOL];
+  for (auto &page : all) {
+    page = pool->acquire();
+    CHECK(page && reinterpret_cast<uintptr_t>(page) % DESTRUCTIVE_INTERFERENCE_SIZE == 0);
+  }
+  CHECK(pool->acquire() == nullptr);
+  pool->publish_n(all, POOL);
+  CHECK(pool->consume_all([](Page &) noexcept {}) == POOL);
+  CHECK(pool->available() == POOL);
+
+  std::thread consumer([&pool] {
+    uint64_t expected = 0;
+    while (expected < ITEMS) {
+      if (expected % 3 == 0) {
+        Page *page = pool->receive_wait();
+        CHECK(page->in_flight && page->seq == expected++);
+        page->in_flight = false;
+        pool->release(page);
+      } else {
+        pool->consume_all([&expected](Page &page) noexcept {
+          CHECK(page.in_flight && page.seq == expected++);
+          page.in_flight = false;
+        }, ITEMS - expected);
+      }
+    }
+  });
+
+  for (uint64_t i = 0; i < ITEMS; ++i) {
+    Page *page = pool->acquire_wait();
+    CHECK(!page->in_flight);
+    page->in_flight = true;
+    page->seq       = i;
+    pool->publish(page);
+  }
+  consumer.join();
+
+  CHECK(pool->size() == 0 && pool->available() == POOL);
+  return 0;
+}
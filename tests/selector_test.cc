@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "RingMasterSelector.hh"
+#include "check.hh"
+
+/**
+ * @brief Ring selector: one consumer waiting on rings that span several
+ * bitmap words receives each ring's elements in order from several producer
+ * threads, and a direct push followed by signal() is noticed
+ */
+
+using Ring = RingMaster<size_t, 64>;
+
+static constexpr size_t RINGS     = 70; // more than one 64-bit readiness word
+static constexpr size_t PRODUCERS = 5;
+static constexpr size_t ITEMS     = 5000; // per ring
+
+int main() {
+  std::vector<Ring>                   rings(RINGS);
+  ringmaster::RingSelector<Ring, 128> selector;
+  for (auto &ring : rings) selector.add(ring);
+
+  // Producer t owns rings t, t + PRODUCERS, ...
+  std::vector<std::thread> producers;
+  for (size_t t = 0; t < PRODUCERS; ++t) {
+    producers.emplace_back([&selector, t] {
+      for (size_t i = 0; i < ITEMS; ++i) {
+        for (size_t id = t; id < RINGS; id += PRODUCERS) {
+          while (!selector.push(id, i)) std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<size_t> next(RINGS, 0);
+  size_t              total = 0;
+  while (total < RINGS * ITEMS) {
+    total += selector.wait([&next](size_t id, size_t &value) noexcept {
+      CHECK(value == next[id]);
+      ++next[id];
+    });
+  }
+  for (auto &producer : producers) producer.join();
+
+  for (size_t count : next) CHECK(count == ITEMS);
+  CHECK(selector.drain([](size_t, size_t &) noexcept {}) == 0 && !selector.anyReady());
+
+  // A producer bypassing the selector announces the element with signal()
+  CHECK(rings[RINGS - 1].push(size_t{42}));
+  selector.signal(RINGS - 1);
+  size_t seen = 0;
+  CHECK(selector.wait([&seen](size_t id, size_t &value) noexcept {
+    CHECK(id == RINGS - 1 && value == 42);
+    ++seen;
+  }) == 1);
+  CHECK(seen == 1);
+
+  // Registration is bounded by MaxRings
+  ringmaster::RingSelector<Ring, 1> small;
+  small.add(rings[0]);
+  bool threw = false;
+  try {
+    small.add(rings[1]);
+  } catch (const std::length_error &) {
+    threw = true;
+  }
+  CHECK(threw);
+  return 0;
+}
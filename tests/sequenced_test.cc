@@ -0,0 +1,66 @@
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief MPSC and MPMC rings: every element delivered exactly once, in
+ * per-producer order
+ *
+ * Elements carry their producer and a per-producer sequence number. Any one
+ * consumer must see each producer's sequence increase, and across all
+ * consumers every element must arrive exactly once.
+ */
+
+static constexpr uint32_t PRODUCERS = 2;
+static constexpr uint32_t ITEMS     = 100000; // per producer
+static constexpr uint32_t STOP      = ~uint32_t(0);
+
+struct Item {
+  uint32_t producer;
+  uint32_t seq;
+};
+
+template<typename RING> void run(RING &ring, uint32_t consumers) {
+  std::vector<std::atomic<uint32_t>> seen(PRODUCERS);
+  std::vector<std::thread>           threads;
+
+  for (uint32_t p = 0; p < PRODUCERS; ++p) {
+    threads.emplace_back([&ring, p] {
+      for (uint32_t i = 0; i < ITEMS; ++i) ring.push_wait(Item{p, i});
+    });
+  }
+  for (uint32_t c = 0; c < consumers; ++c) {
+    threads.emplace_back([&ring, &seen] {
+      int64_t last[PRODUCERS];
+      for (auto &l : last) l = -1;
+      Item item;
+      while (ring.pop_wait(item) && item.seq != STOP) {
+        CHECK(item.producer < PRODUCERS);
+        CHECK(static_cast<int64_t>(item.seq) > last[item.producer]);
+        last[item.producer] = item.seq;
+        seen[item.producer].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  for (uint32_t p = 0; p < PRODUCERS; ++p) threads[p].join();
+  // One stop marker per consumer, pushed after every real element
+  for (uint32_t c = 0; c < consumers; ++c) ring.push_wait(Item{0, STOP});
+  for (uint32_t c = 0; c < consumers; ++c) threads[PRODUCERS + c].join();
+
+  for (auto &count : seen) CHECK(count.load() == ITEMS);
+  CHECK(ring.isEmpty());
+}
+
+int main() {
+  static MPSCRingMaster<Item, 256> mpsc;
+  run(mpsc, 1);
+
+  static MPMCRingMaster<Item, 256> mpmc;
+  run(mpmc, 2);
+  return 0;
+}
@@ -0,0 +1,65 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "RingMasterShm.hh"
+#include "check.hh"
+
+/**
+ * @brief Shared-memory ring: FIFO order from a parent producer to a forked
+ * consumer process, layout validation on open(), and unlink()
+ */
+
+struct Tick {
+  uint64_t seq;
+  double   price;
+};
+
+static constexpr uint64_t ITEMS = 200000;
+
+int main() {
+  const std::string name = "/ringmaster_shm_test_" + std::to_string(::getpid());
+  auto              ring = ShmRingMaster<Tick>::create(name, 64);
+
+  const pid_t child = ::fork();
+  CHECK(child >= 0);
+  if (child == 0) {
+    auto consumer = ShmRingMaster<Tick>::open(name);
+    Tick tick;
+    for (uint64_t expected = 0; expected < ITEMS; ++expected) {
+      consumer.pop_wait(tick);
+      if (tick.seq != expected || tick.price != expected * 0.5) ::_exit(1);
+    }
+    ::_exit(consumer.isEmpty() ? 0 : 1);
+  }
+
+  for (uint64_t i = 0; i < ITEMS; ++i) ring.push_wait(Tick{i, i * 0.5});
+
+  int status = 0;
+  CHECK(::waitpid(child, &status, 0) == child);
+  CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  CHECK(ring.isEmpty());
+
+  // A mapping with a different element type is refused
+  bool threw = false;
+  try {
+    ShmRingMaster<uint64_t>::open(name);
+  } catch (const std::runtime_error &) {
+    threw = true;
+  }
+  CHECK(threw);
+
+  // After unlink() the name no longer resolves
+  ShmRingMaster<Tick>::unlink(name);
+  threw = false;
+  try {
+    ShmRingMaster<Tick>::open(name);
+  } catch (const std::exception &) {
+    threw = true;
+  }
+  CHECK(threw);
+  return 0;
+}
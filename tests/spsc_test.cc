@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief SPSC ring: FIFO order across two threads with the blocking calls,
+ * close() waking a parked consumer and producer, and the timed calls giving
+ * up at their deadline
+ */
+
+using namespace std::chrono_literals;
+
+static constexpr uint64_t ITEMS = 200000;
+
+int main() {
+  // Ordering, then close() ending the consumer once the ring is drained
+  {
+    static RingMaster<uint64_t, 64> ring;
+
+    std::thread producer([] {
+      for (uint64_t i = 0; i < ITEMS; ++i) CHECK(ring.push_wait(i, 16));
+      ring.close();
+    });
+
+    uint64_t value    = 0;
+    uint64_t expected = 0;
+    while (ring.pop_wait(value, 16)) CHECK(value == expected++);
+    producer.join();
+    CHECK(expected == ITEMS && ring.isEmpty());
+  }
+
+  // close() wakes a consumer parked on an empty ring
+  {
+    static RingMaster<uint64_t, 64, false, ringmaster::BlockWait> ring;
+    std::thread consumer([] {
+      uint64_t value = 0;
+      CHECK(!ring.pop_wait(value));
+    });
+    std::this_thread::sleep_for(20ms);
+    ring.close();
+    consumer.join();
+  }
+
+  // close() wakes a producer parked on a full ring
+  {
+    static RingMaster<uint64_t, 64, false, ringmaster::BlockWait> ring;
+    while (ring.push(uint64_t{0})) {}
+    std::thread producer([] { CHECK(!ring.push_wait(uint64_t{1})); });
+    std::this_thread::sleep_for(20ms);
+    ring.close();
+    producer.join();
+    CHECK(ring.size() == 64);
+  }
+
+  // Timed calls give up at the deadline, and succeed once the other side acts
+  {
+    static RingMaster<uint64_t, 64> ring;
+
+    uint64_t value = 0;
+    auto     start = std::chrono::steady_clock::now();
+    CHECK(!ring.try_pop_for(value, 10ms));
+    CHECK(std::chrono::steady_clock::now() - start >= 10ms);
+
+    while (ring.push(uint64_t{5})) {}
+    start = std::chrono::steady_clock::now();
+    CHECK(!ring.try_push_for(uint64_t{6}, 10ms));
+    CHECK(std::chrono::steady_clock::now() - start >= 10ms);
+
+    // One pop on another thread makes room for the timed push
+    std::thread consumer([] {
+      uint64_t v = 0;
+      CHECK(ring.pop_wait(v) && v == 5);
+    });
+    CHECK(ring.try_push_for(uint64_t{7}, 5s));
+    consumer.join();
+
+    for (size_t i = 0; i < 63; ++i) CHECK(ring.pop(value) && value == 5);
+    CHECK(ring.try_pop_until(value, std::chrono::steady_clock::now() + 5s) && value == 7);
+  }
+  return 0;
+}
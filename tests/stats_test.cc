@@ -0,0 +1,78 @@
+#include <cstdint>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief CountingStats: after a known sequence of operations snapshot()
+ * reports exactly the pushes, pops, full and empty hits, spins and parks
+ * they imply
+ *
+ * BlockWait parks after a single failed attempt, so every park below costs
+ * exactly one spin and one full or empty hit. The main thread polls
+ * snapshot() to learn that the other thread has parked, as a monitoring
+ * thread would.
+ */
+
+using Ring = RingMaster<int, 4, false, ringmaster::BlockWait, ringmaster::CountingStats>;
+
+static Ring ring;
+
+static void wait_for(uint64_t ringmaster::StatsSnapshot::*counter, uint64_t value) {
+  while (ring.stats().snapshot().*counter < value) std::this_thread::yield();
+}
+
+int main() {
+  auto s = ring.stats().snapshot();
+  CHECK(s.pushes == 0 && s.pops == 0 && s.full_hits == 0 && s.empty_hits == 0);
+
+  // Non-waiting calls: two full hits, one empty hit
+  int batch[8] = {};
+  for (int i = 0; i < 4; ++i) CHECK(ring.push(i));
+  CHECK(!ring.push(4));
+  CHECK(ring.push_n(batch, 8) == 0);
+  int value = 0;
+  // A zero budget is neither a full nor an empty hit
+  CHECK(ring.consume_all([](int &) {}, 0) == 0);
+  CHECK(ring.pop_n(batch, 0) == 0);
+  CHECK(ring.pop(value) && value == 0);
+  CHECK(ring.push_n(batch, 0) == 0);
+  CHECK(ring.pop_n(batch, 8) == 3);
+  CHECK(!ring.pop(value));
+
+  s = ring.stats().snapshot();
+  CHECK(s.pushes == 4 && s.pops == 4 && s.full_hits == 2 && s.empty_hits == 1);
+  CHECK(s.producer_spins == 0 && s.consumer_spins == 0);
+  CHECK(s.producer_parks == 0 && s.consumer_parks == 0);
+
+  // The consumer parks once on the empty ring
+  std::thread consumer([&value] { CHECK(ring.pop_wait(value) && value == 10); });
+  wait_for(&ringmaster::StatsSnapshot::consumer_parks, 1);
+  CHECK(ring.push_wait(10));
+  consumer.join();
+
+  // The producer parks once on the full ring
+  for (int i = 0; i < 4; ++i) CHECK(ring.push(20 + i));
+  std::thread producer([] { CHECK(ring.push_wait(24)); });
+  wait_for(&ringmaster::StatsSnapshot::producer_parks, 1);
+  CHECK(ring.pop_wait(value) && value == 20);
+  producer.join();
+
+  s = ring.stats().snapshot();
+  CHECK(s.pushes == 10 && s.pops == 6 && s.full_hits == 3 && s.empty_hits == 2);
+  CHECK(s.producer_spins == 1 && s.consumer_spins == 1);
+  CHECK(s.producer_parks == 1 && s.consumer_parks == 1);
+
+  // Draining a closed ring: the final pop_wait() fails after one spin and
+  // two empty hits, without parking
+  ring.close();
+  for (int i = 21; i < 25; ++i) CHECK(ring.pop_wait(value) && value == i);
+  CHECK(!ring.pop_wait(value));
+
+  s = ring.stats().snapshot();
+  CHECK(s.pushes == 10 && s.pops == 10 && s.full_hits == 3 && s.empty_hits == 4);
+  CHECK(s.producer_spins == 1 && s.consumer_spins == 2);
+  CHECK(s.producer_parks == 1 && s.consumer_parks == 1);
+  return 0;
+}
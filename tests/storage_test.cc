@@ -0,0 +1,90 @@
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Raw slot storage: a fresh ring constructs no elements, and every
+ * element the ring holds is destroyed exactly once by pop(), consume(),
+ * remove(), clear() or the destructor, including elements left across the
+ * wrap point
+ *
+ * The element has no default constructor and counts its live instances.
+ * It holds a std::string so that a missed or doubled destruction also
+ * shows up under a leak checker. Both a contiguous (dense) ring and a
+ * swizzled one, whose destroy() visits the slots one by one, are covered.
+ */
+
+struct Counted {
+  static inline int live = 0;
+
+  std::string text;
+
+  explicit Counted(std::string s) : text(std::move(s)) { ++live; }
+  Counted(Counted &&other) noexcept : text(std::move(other.text)) { ++live; }
+  Counted &operator=(Counted &&other) noexcept = default;
+  ~Counted() { --live; }
+};
+
+static_assert(!std::is_default_constructible_v<Counted>);
+
+using Dense    = RingMaster<Counted, 8>;
+using Swizzled = RingMaster<Counted, 8, true, ringmaster::HybridWait<>, ringmaster::NullStats,
+    ringmaster::SwizzledLayout<>>;
+
+template<typename Ring> static void lifetimes() {
+  CHECK(Counted::live == 0);
+  {
+    Ring ring;
+    CHECK(Counted::live == 0); // no slot holds an element yet
+
+    for (int i = 0; i < 6; ++i) CHECK(ring.push(Counted(std::to_string(i))));
+    CHECK(Counted::live == 6);
+
+    // pop() by value: the slot's element is destroyed, the returned one lives
+    auto first = ring.pop();
+    CHECK(first && first->text == "0" && Counted::live == 6);
+    first.reset();
+    CHECK(Counted::live == 5);
+
+    // pop(Q_TYPE &) moves into an existing element
+    Counted out("out");
+    CHECK(ring.pop(out) && out.text == "1" && Counted::live == 5);
+
+    // consume() destroys the element after visiting it
+    CHECK(ring.consume([](Counted &c) { CHECK(c.text == "2"); }));
+    CHECK(Counted::live == 4);
+
+    // remove() destroys without handing anything out
+    CHECK(ring.remove(2) == 2 && Counted::live == 2);
+
+    // Fill the ring across the wrap point; a failed push leaks nothing
+    for (int i = 6; i < 13; ++i) CHECK(ring.push(Counted(std::to_string(i))));
+    CHECK(ring.isFull() && Counted::live == 9);
+    CHECK(!ring.push(Counted("full")));
+    CHECK(Counted::live == 9);
+
+    CHECK(ring.remove(3) == 3 && Counted::live == 6);
+    CHECK(ring.pop()->text == "8"); // the returned element dies with the expression
+    CHECK(Counted::live == 5);
+
+    // clear() destroys what is left, across the wrap
+    ring.clear();
+    CHECK(ring.isEmpty() && Counted::live == 1);
+
+    // Leave five elements spanning the wrap point for the destructor
+    for (int i = 0; i < 6; ++i) CHECK(ring.push(Counted(std::to_string(i))));
+    CHECK(ring.remove(6) == 6);
+    for (int i = 0; i < 5; ++i) CHECK(ring.push(Counted(std::to_string(i))));
+    CHECK(Counted::live == 6);
+  }
+  CHECK(Counted::live == 0);
+}
+
+int main() {
+  lifetimes<Dense>();
+  lifetimes<Swizzled>();
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Streaming copies: batches of at least STREAMING_COPY_THRESHOLD bytes
+ * arrive intact whatever the alignment of their first slot, including both
+ * halves of a batch split by the wrap point
+ *
+ * bulk_copy() is driven directly at every offset within a cache line, so the
+ * unaligned head, the non-temporal body and the tail are all exercised, and
+ * then through push_n()/pop_n() on a runtime-capacity ring.
+ */
+
+using ringmaster::detail::STREAMING_COPY_THRESHOLD;
+
+static constexpr size_t T = STREAMING_COPY_THRESHOLD / sizeof(uint32_t) + 1; // streams
+
+static std::vector<uint32_t> pattern(size_t n, uint32_t seed) {
+  std::vector<uint32_t> v(n);
+  for (size_t i = 0; i < n; ++i) v[i] = seed + static_cast<uint32_t>(i) * 2654435761u;
+  return v;
+}
+
+static void bulk_copy_offsets() {
+  const size_t      bytes = STREAMING_COPY_THRESHOLD + 37;
+  std::vector<char> src(bytes);
+  for (size_t i = 0; i < bytes; ++i) src[i] = static_cast<char>(i * 131 + 7);
+
+  std::vector<char> dst(bytes + 2 * 64);
+  char *const       base = dst.data() + (64 - reinterpret_cast<uintptr_t>(dst.data()) % 64);
+  for (size_t offset = 0; offset < 64; offset += 5) {
+    std::memset(dst.data(), 0, dst.size());
+    ringmaster::detail::bulk_copy(base + offset, src.data(), bytes);
+    CHECK(std::memcmp(base + offset, src.data(), bytes) == 0);
+    CHECK(base[offset - 1] == 0 && base[offset + bytes] == 0); // nothing outside
+  }
+}
+
+static void ring_batches() {
+  using Ring = RingMaster<uint32_t, ringmaster::DynamicCapacity>;
+  const size_t capacity = std::bit_ceil(4 * T);
+  Ring         ring(capacity);
+
+  // Start one slot in, so the first batch lands on an unaligned slot
+  CHECK(ring.push(uint32_t{0}) && ring.pop() == uint32_t{0});
+  const auto first = pattern(T + 3, 1);
+  CHECK(ring.push_n(first.begin(), first.size()) == first.size());
+  std::vector<uint32_t> out(capacity);
+  CHECK(ring.pop_n(out.begin(), first.size()) == first.size());
+  CHECK(std::memcmp(out.data(), first.data(), first.size() * sizeof(uint32_t)) == 0);
+
+  // Move head to T + 5 slots before the end, then push a batch whose two
+  // segments are both above the threshold
+  const size_t advance = capacity - (T + 5) - (1 + first.size());
+  CHECK(ring.push_n(out.begin(), advance) == advance && ring.remove(advance) == advance);
+
+  const auto wrapped = pattern(2 * T + 11, 2);
+  auto       claim   = ring.try_claim(wrapped.size());
+  CHECK(claim.first.size() == T + 5 && claim.second.size() == T + 6);
+  CHECK(ring.push_n(wrapped.begin(), wrapped.size()) == wrapped.size());
+  CHECK(ring.pop_n(out.begin(), out.size()) == wrapped.size());
+  CHECK(std::memcmp(out.data(), wrapped.data(), wrapped.size() * sizeof(uint32_t)) == 0);
+  CHECK(ring.isEmpty());
+}
+
+int main() {
+  bulk_copy_offsets();
+  ring_batches();
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "RingMaster.hh"
+#include "check.hh"
+
+/**
+ * @brief Wait strategies: push_wait()/pop_wait() keep FIFO order across two
+ * threads with every strategy, close() ends a pop_wait() whether or not the
+ * strategy parks, and timed pops on an empty ring give up at their deadline
+ *
+ * The non-parking strategies compile wake() down to nothing, so these rings
+ * only ever make progress through the waiter's own retries.
+ */
+
+using namespace std::chrono_literals;
+
+static constexpr uint64_t ITEMS = 20000;
+
+template<typename STRATEGY> static void exchange() {
+  using Ring = RingMaster<uint64_t, 64, false, STRATEGY>;
+  static Ring ring;
+
+  std::thread producer([] {
+    for (uint64_t i = 0; i < ITEMS; ++i) CHECK(ring.push_wait(i, 64));
+    ring.close();
+  });
+
+  uint64_t value    = 0;
+  uint64_t expected = 0;
+  while (ring.pop_wait(value, 64)) CHECK(value == expected++);
+  producer.join();
+  CHECK(expected == ITEMS && ring.isEmpty());
+
+  // Closed and drained: pop_wait() returns at once
+  CHECK(!ring.pop_wait(value));
+
+  // An open, empty ring: the timed pop waits out its deadline
+  Ring open;
+  const auto start = std::chrono::steady_clock::now();
+  CHECK(!open.try_pop_for(value, 5ms));
+  CHECK(std::chrono::steady_clock::now() - start >= 5ms);
+}
+
+int main() {
+  exchange<ringmaster::BusySpinWait>();
+  exchange<ringmaster::BackoffWait<>>();
+  exchange<ringmaster::YieldWait>();
+  exchange<ringmaster::BlockWait>();
+  exchange<ringmaster::HybridWait<>>();
+  return 0;
+}
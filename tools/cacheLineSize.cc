@@ -1,7 +1,11 @@
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <set>
+#include <string>
+#include <thread>
 
-// macOS: sysctlbyname for cache-line size
+// macOS: sysctlbyname for cache sizes and core counts
 #if defined(__APPLE__)
 #include <sys/sysctl.h>
 #endif
@@ -17,6 +21,34 @@
 #include <windows.h>
 #endif
 
+/*
+ * Cache and topology probe
+ *
+ * Prints one KEY=VALUE line per property; CMakeLists.txt turns every line
+ * into a compile definition for RingMaster:
+ *
+ *   CACHE_LINE_SIZE                L1D line size in bytes
+ *   DESTRUCTIVE_INTERFERENCE_SIZE  Spacing that keeps two variables from
+ *                                  ever sharing a line or prefetch pair
+ *   L1D_CACHE_SIZE                 Per-core L1 data cache in bytes
+ *   L2_CACHE_SIZE                  L2 cache in bytes
+ *   CPU_CORES                      Physical cores
+ *   HW_THREADS                     Logical CPUs
+ *   SMT_WIDTH                      Hardware threads per core
+ *
+ * Every value falls back to a conservative default when it cannot be read.
+ */
+
+struct Probe {
+  size_t line      = 0;
+  size_t l1d       = 0;
+  size_t l2        = 0;
+  size_t cores     = 0;
+  size_t threads   = 0;
+  size_t smt_width = 0;
+  bool   intel     = false; /**< Adjacent-line prefetcher pairs 64-byte lines */
+};
+
 // -----------------------------
 // 1) Compile-time fallback
 // -----------------------------
@@ -32,45 +64,122 @@ constexpr size_t compile_cacheline =
 // -----------------------------
 #if defined(__x86_64__) || defined(__i386__)
 #include <cpuid.h>
-size_t detect_x86() {
+/**
+ * Walk the deterministic cache parameters (leaf 4 on Intel, 0x8000001D on
+ * AMD) for the L1D and L2 sizes and line size. Leaf 1 only reports the
+ * CLFLUSH granularity and is used as the last resort for the line size.
+ */
+void detect_x86(Probe &p) {
   unsigned eax, ebx, ecx, edx;
-  __cpuid(1, eax, ebx, ecx, edx);
-  return ((ebx >> 8) & 0xFF) * 8;
+  __cpuid(0, eax, ebx, ecx, edx);
+  p.intel = (ebx == 0x756e6547 && edx == 0x49656e69 && ecx == 0x6c65746e); // "GenuineIntel"
+
+  const unsigned leaf = p.intel ? 4u : 0x8000001Du;
+  for (unsigned sub = 0; sub < 16; ++sub) {
+    if (!__get_cpuid_count(leaf, sub, &eax, &ebx, &ecx, &edx)) break;
+    const unsigned type = eax & 0x1F; // 0 = no more caches, 1 = data, 3 = unified
+    if (type == 0) break;
+    const unsigned level = (eax >> 5) & 0x7;
+    const size_t   line  = (ebx & 0xFFF) + 1;
+    const size_t   size  = (((ebx >> 22) & 0x3FF) + 1) * (((ebx >> 12) & 0x3FF) + 1) * line *
+                        (size_t(ecx) + 1);
+    if (level == 1 && type == 1) {
+      if (!p.line) p.line = line;
+      if (!p.l1d) p.l1d = size;
+    }
+    if (level == 2 && type != 2 && !p.l2) p.l2 = size;
+  }
+
+  if (!p.line) {
+    __cpuid(1, eax, ebx, ecx, edx);
+    p.line = ((ebx >> 8) & 0xFF) * 8;
+  }
 }
 #else
-constexpr size_t detect_x86() {
-  return 0;
-}
+void detect_x86(Probe &) {}
 #endif
 
 // -----------------------------
 // 3) Linux sysfs detection
 // -----------------------------
 #if defined(__linux__)
-size_t detect_linux_sysfs() {
-  std::ifstream f("/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size");
+size_t read_size(const std::string &path) {
+  std::ifstream f(path);
   size_t        v = 0;
-  if (f >> v) return v; // bytes
-  return 0;
+  std::string   unit;
+  if (!(f >> v)) return 0;
+  if (f >> unit) {
+    if (unit[0] == 'K') v <<= 10;
+    if (unit[0] == 'M') v <<= 20;
+  }
+  return v;
+}
+
+std::string read_line(const std::string &path) {
+  std::ifstream f(path);
+  std::string   s;
+  std::getline(f, s);
+  return s;
+}
+
+void detect_linux_sysfs(Probe &p) {
+  const std::string cpu0 = "/sys/devices/system/cpu/cpu0/cache/index";
+  for (int i = 0; i < 8; ++i) {
+    const std::string dir   = cpu0 + std::to_string(i) + "/";
+    const size_t      level = read_size(dir + "level");
+    if (level == 0) break;
+    const std::string type = read_line(dir + "type");
+    if (level == 1 && type == "Data") {
+      if (!p.line) p.line = read_size(dir + "coherency_line_size");
+      if (!p.l1d) p.l1d = read_size(dir + "size");
+    }
+    if (level == 2 && type != "Instruction" && !p.l2) p.l2 = read_size(dir + "size");
+  }
+
+  // Physical cores: distinct (package, core) pairs among the online CPUs
+  std::set<std::pair<long, long>> cores;
+  size_t                          threads = 0;
+  for (int cpu = 0; cpu < 4096; ++cpu) {
+    const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    std::ifstream     pkg(dir + "physical_package_id"), core(dir + "core_id");
+    long              pkg_id = -1, core_id = -1;
+    if (!(pkg >> pkg_id) || !(core >> core_id)) {
+      if (cpu > 0 && threads > 0) break;
+      continue;
+    }
+    cores.insert({pkg_id, core_id});
+    ++threads;
+  }
+  if (threads) {
+    p.threads = threads;
+    p.cores   = cores.size();
+  }
 }
 #endif
 
 // -----------------------------
 // 4) Combined runtime detection
 // -----------------------------
-size_t get_cacheline_runtime() {
-  size_t cls = 0;
+Probe probe_runtime() {
+  Probe p;
 
   // macOS (Intel & Apple Silicon)
 #if defined(__APPLE__)
-  size_t len = sizeof(cls);
-  if (sysctlbyname("hw.cachelinesize", &cls, &len, nullptr, 0) == 0) return cls;
+  auto sysctl_size = [](const char *name) -> size_t {
+    uint64_t v   = 0;
+    size_t   len = sizeof(v);
+    return sysctlbyname(name, &v, &len, nullptr, 0) == 0 ? static_cast<size_t>(v) : 0;
+  };
+  p.line    = sysctl_size("hw.cachelinesize");
+  p.l1d     = sysctl_size("hw.l1dcachesize");
+  p.l2      = sysctl_size("hw.l2cachesize");
+  p.cores   = sysctl_size("hw.physicalcpu");
+  p.threads = sysctl_size("hw.logicalcpu");
 #endif
 
-    // Linux fallback: sysfs
+    // Linux: sysfs
 #if defined(__linux__)
-  cls = detect_linux_sysfs();
-  if (cls > 0) return cls;
+  detect_linux_sysfs(p);
 #endif
 
     // Windows: WinAPI Cache info
@@ -83,20 +192,46 @@ size_t get_cacheline_runtime() {
     auto  *info  = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION *>(buf.data());
     size_t count = needed / sizeof(*info);
     for (size_t i = 0; i < count; ++i) {
-      if (info[i].Relationship == RelationCache && info[i].Cache.Level == 1)
-        return info[i].Cache.LineSize;
+      if (info[i].Relationship == RelationCache && info[i].Cache.Level == 1 &&
+          info[i].Cache.Type != CacheInstruction) {
+        if (!p.line) p.line = info[i].Cache.LineSize;
+        if (!p.l1d) p.l1d = info[i].Cache.Size;
+      }
+      if (info[i].Relationship == RelationCache && info[i].Cache.Level == 2 && !p.l2) {
+        p.l2 = info[i].Cache.Size;
+      }
+      if (info[i].Relationship == RelationProcessorCore) ++p.cores;
     }
   }
 #endif
 
-  // x86 CPUID fallback
-  if (size_t x = detect_x86()) return x;
+  // x86 CPUID fills whatever the OS did not report (and identifies Intel)
+  detect_x86(p);
 
-  // final fallback: compile-time guess
-  return compile_cacheline;
+  // final fallbacks: compile-time guess and conservative sizes
+  if (!p.line) p.line = compile_cacheline;
+  if (!p.l1d) p.l1d = 32 * 1024;
+  if (!p.l2) p.l2 = 256 * 1024;
+  if (!p.threads) p.threads = std::thread::hardware_concurrency();
+  if (!p.threads) p.threads = 1;
+  if (!p.cores) p.cores = p.threads;
+  p.smt_width = (p.threads >= p.cores && p.cores) ? p.threads / p.cores : 1;
+  return p;
 }
 
 int main() {
-  std::cout << get_cacheline_runtime();
+  const Probe p = probe_runtime();
+
+  // Intel's spatial prefetcher fetches 64-byte lines in aligned pairs, so
+  // variables written by different cores need 128 bytes between them
+  const size_t interference = (p.intel && p.line < 128) ? 2 * p.line : p.line;
+
+  std::cout << "CACHE_LINE_SIZE=" << p.line << "\n"
+            << "DESTRUCTIVE_INTERFERENCE_SIZE=" << interference << "\n"
+            << "L1D_CACHE_SIZE=" << p.l1d << "\n"
+            << "L2_CACHE_SIZE=" << p.l2 << "\n"
+            << "CPU_CORES=" << p.cores << "\n"
+            << "HW_THREADS=" << p.threads << "\n"
+            << "SMT_WIDTH=" << p.smt_width << "\n";
   return 0;
 }